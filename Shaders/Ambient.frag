@@ -0,0 +1,16 @@
+#version 450
+
+// Has to match Lighting.frag and ComputeLighting.comp
+#define AMBIENT 0.01f
+
+layout(location = 0) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+layout(set = 0, binding = 0) uniform sampler2D albedoSampler;
+
+// Light volumes add the point lights on top of this
+void main()
+{
+    outColor = vec4(AMBIENT * texture(albedoSampler, fragTexCoord).rgb, 1.0f);
+}
@@ -1,6 +1,18 @@
 glslc Geometry.vert         -o GeometryVert.spv
-glslc Geometry.frag         -o GeometryFrag.spv
+glslc DepthPrepass.vert     -o DepthPrepassVert.spv
+glslc Geometry.frag         -o GeometryFrag.spv --target-env=vulkan1.2
+glslc Geometry.frag         -o GeometryCompactFrag.spv --target-env=vulkan1.2 -DCOMPACT_GBUFFER
 glslc FullScreenQuad.vert   -o FullScreenQuadVert.spv
 glslc Lighting.frag         -o LightingFrag.spv
+glslc Lighting.frag         -o LightingCompactFrag.spv -DCOMPACT_GBUFFER
+glslc Ambient.frag          -o AmbientFrag.spv
+glslc LightVolume.vert      -o LightVolumeVert.spv
+glslc LightVolume.frag      -o LightVolumeFrag.spv
+glslc LightVolume.frag      -o LightVolumeCompactFrag.spv -DCOMPACT_GBUFFER
 glslc Tonemapping.frag      -o TonemappingFrag.spv
+glslc Culling.comp          -o CullingComp.spv
+glslc DepthPyramid.comp     -o DepthPyramidComp.spv
+glslc LightCulling.comp     -o LightCullingComp.spv
+glslc ComputeLighting.comp  -o ComputeLightingComp.spv
+glslc ComputeLighting.comp  -o ComputeLightingCompactComp.spv -DCOMPACT_GBUFFER
 pause
\ No newline at end of file
@@ -0,0 +1,36 @@
+#version 450
+
+// Position only, the other vertex attributes are bound but never read
+layout(location = 0) in vec3 inPosition;
+
+// Has to compute gl_Position exactly like Geometry.vert, the geometry pass tests against this depth with EQUAL
+invariant gl_Position;
+
+layout(set = 0, binding = 0) uniform CameraBufferObject
+{
+    mat4 view;
+    mat4 proj;
+    mat4 projView;
+} cbo;
+
+// Has to match Geometry.vert
+struct DrawData
+{
+    mat4 model;
+    vec3 boundsCenter;
+    uint materialIndex;
+    vec3 boundsExtent;
+    uint groupIndex;
+    uint visibilityIndex;
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer DrawDataBuffer
+{
+    DrawData draws[];
+} drawBuffer;
+
+void main()
+{
+    mat4 model  = drawBuffer.draws[gl_InstanceIndex].model;
+    gl_Position = cbo.projView * model * vec4(inPosition, 1.0);
+}
@@ -1,29 +1,42 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 layout(location = 0) in vec3 fragPos;
 layout(location = 1) in vec3 fragNormal;
 layout(location = 2) in vec2 fragTexCoord;
 layout(location = 3) in mat3 fragTBN;
+layout(location = 6) flat in uint fragMaterialIndex;
 
+// Compiled once more with COMPACT_GBUFFER for Renderer::RendererInfo::compactGBuffer
+#ifdef COMPACT_GBUFFER
+layout(location = 0) out vec4 albedoAttachment;
+layout(location = 1) out vec4 normalAttachment;
+#else
 layout(location = 0) out vec4 albedoAttachment;
 layout(location = 1) out vec4 positionAttachment;
 layout(location = 2) out vec4 normalAttachment;
+#endif
 
-layout(set = 1, binding = 0) uniform sampler2D albedoTexSampler;
-layout(set = 1, binding = 1) uniform sampler2D normalTexSampler;
-layout(set = 1, binding = 2) uniform sampler2D metallicRoughnessTexSampler;
-
-layout(push_constant) uniform MaterialObject
+struct MaterialObject
 {
-    layout(offset = 64)
     vec4    albedoColor;
     float   metallicFactor;
     float   roughnessFactor;
-} matObject;
+    uint    albedoTexture;
+    uint    normalTexture;
+    uint    metallicRoughnessTexture;
+};
 
-vec4 TangentToWorld()
+// Bindless material table, textures are indexed through the material of the draw
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+layout(std430, set = 1, binding = 1) readonly buffer MaterialBuffer
 {
-    vec3 normal = texture(normalTexSampler, fragTexCoord).rgb;
+    MaterialObject materials[];
+} materialBuffer;
+
+vec4 TangentToWorld(MaterialObject matObject)
+{
+    vec3 normal = texture(textures[nonuniformEXT(matObject.normalTexture)], fragTexCoord).rgb;
     normal = normalize(normal * 2.0 - 1.0);
 
     vec3 result = normalize(fragTBN * normal);
@@ -31,13 +44,35 @@ vec4 TangentToWorld()
     return vec4(result, 1.0);
 }
 
+// Unit normal onto the octahedron, its lower half folded over the upper one. Has to match OctahedronDecode in the lighting shaders
+vec2 OctahedronEncode(vec3 normal)
+{
+    normal /= abs(normal.x) + abs(normal.y) + abs(normal.z);
+    vec2 signs = mix(vec2(-1.0), vec2(1.0), greaterThanEqual(normal.xy, vec2(0.0)));
+    vec2 encoded = normal.z >= 0.0 ? normal.xy : (1.0 - abs(normal.yx)) * signs;
+    return encoded * 0.5 + 0.5;
+}
+
 void main()
 {
+    MaterialObject matObject    = materialBuffer.materials[fragMaterialIndex];
+    vec4 metallicRoughness      = texture(textures[nonuniformEXT(matObject.metallicRoughnessTexture)], fragTexCoord);
+
+    float metallic              = metallicRoughness.b * matObject.metallicFactor;
+    float roughness             = metallicRoughness.g * matObject.roughnessFactor;
+    vec3 albedo                 = texture(textures[nonuniformEXT(matObject.albedoTexture)], fragTexCoord).rgb;
+
+#ifdef COMPACT_GBUFFER
+    // Position comes back from depth. Octahedral normal in RG, roughness in B and metallic in the two bit A channel
+    albedoAttachment    = vec4(albedo, 1.0);
+    normalAttachment    = vec4(OctahedronEncode(TangentToWorld(matObject).xyz), roughness, metallic);
+#else
     // Metallic in A channel
-    albedoAttachment    = vec4(texture(albedoTexSampler, fragTexCoord).rgb, texture(metallicRoughnessTexSampler, fragTexCoord).b * matObject.metallicFactor);
+    albedoAttachment    = vec4(albedo, metallic);
 
     // Roughness in A Channel
-    positionAttachment  = vec4(fragPos, texture(metallicRoughnessTexSampler, fragTexCoord).g * matObject.roughnessFactor);
+    positionAttachment  = vec4(fragPos, roughness);
 
-    normalAttachment    = normalize(TangentToWorld());
+    normalAttachment    = normalize(TangentToWorld(matObject));
+#endif
 }
\ No newline at end of file
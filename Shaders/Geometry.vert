@@ -9,6 +9,10 @@ layout(location = 0) out vec3 fragPos;
 layout(location = 1) out vec3 fragNormal;
 layout(location = 2) out vec2 fragTexCoord;
 layout(location = 3) out mat3 fragTBN;
+layout(location = 6) flat out uint fragMaterialIndex;
+
+// Has to match DepthPrepass.vert, which lays down the depth the EQUAL test compares against
+invariant gl_Position;
 
 layout(set = 0, binding = 0) uniform CameraBufferObject
 {
@@ -17,20 +21,34 @@ layout(set = 0, binding = 0) uniform CameraBufferObject
     mat4 projView;
 } cbo;
 
-layout(push_constant) uniform PerModel
+struct DrawData
 {
     mat4 model;
-} mbo;
+    vec3 boundsCenter;
+    uint materialIndex;
+    vec3 boundsExtent;
+    uint groupIndex;
+    uint visibilityIndex;
+};
+
+// One entry per draw, firstInstance of every draw holds its index
+layout(std430, set = 2, binding = 0) readonly buffer DrawDataBuffer
+{
+    DrawData draws[];
+} drawBuffer;
 
 void main()
 {
-    gl_Position = cbo.projView * mbo.model * vec4(inPosition, 1.0);
-    fragPos     = vec3(mbo.model * vec4(inPosition, 1.0));
+    mat4 model          = drawBuffer.draws[gl_InstanceIndex].model;
+    fragMaterialIndex   = drawBuffer.draws[gl_InstanceIndex].materialIndex;
+
+    gl_Position = cbo.projView * model * vec4(inPosition, 1.0);
+    fragPos     = vec3(model * vec4(inPosition, 1.0));
 
     fragNormal = normalize(inNormal);
 
     // Normal Matrix
-    mat3 normalMatrix = mat3(mbo.model);
+    mat3 normalMatrix = mat3(model);
 
     // Transform vertex normals and tangents to model space
     vec3 normal = normalize(normalMatrix * inNormal);
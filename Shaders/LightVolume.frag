@@ -0,0 +1,87 @@
+#version 450
+
+struct PointLight
+{
+    vec3    position;
+    vec3    color;
+    float   radius;
+};
+
+layout(location = 0) flat in uint lightIndex;
+
+layout(location = 0) out vec4 outColor;
+
+// Compiled once more with COMPACT_GBUFFER, which samples depth in place of the position target
+layout(set = 0, binding = 0) uniform sampler2D albedoSampler;
+#ifdef COMPACT_GBUFFER
+layout(set = 0, binding = 1) uniform sampler2D depthSampler;
+#else
+layout(set = 0, binding = 1) uniform sampler2D positionSampler;
+#endif
+layout(set = 0, binding = 2) uniform sampler2D normalSampler;
+
+layout(set = 1, binding = 0) uniform ClusterParams
+{
+    mat4    viewMatrix;
+    mat4    inverseProjection;
+    vec2    screenSize;
+    float   nearPlane;
+    float   farPlane;
+    vec3    viewPos;
+    uint    lightCount;
+    mat4    inverseViewProjection;
+} params;
+
+layout(std430, set = 1, binding = 1) readonly buffer LightBuffer
+{
+    PointLight lights[];
+} lightBuffer;
+
+#ifdef COMPACT_GBUFFER
+// Has to match OctahedronEncode in Geometry.frag
+vec3 OctahedronDecode(vec2 encoded)
+{
+    vec2 folded = encoded * 2.0 - 1.0;
+    vec3 normal = vec3(folded, 1.0 - abs(folded.x) - abs(folded.y));
+    float fold  = clamp(-normal.z, 0.0, 1.0);
+    normal.xy  += mix(vec2(fold), vec2(-fold), greaterThanEqual(normal.xy, vec2(0.0)));
+    return normalize(normal);
+}
+
+vec3 ReconstructPosition(vec2 texCoord, float depth)
+{
+    vec4 position = params.inverseViewProjection * vec4(texCoord * 2.0 - 1.0, depth, 1.0);
+    return position.xyz / position.w;
+}
+#endif
+
+// Only back faces behind the G-buffer surface get here, so the surface lies in front of the volume's far side.
+// Surfaces in front of the volume are left to the attenuation window
+void main()
+{
+    vec2 texCoord   = gl_FragCoord.xy / params.screenSize;
+#ifdef COMPACT_GBUFFER
+    // The back face test already left out pixels without geometry
+    vec3 fragPos    = ReconstructPosition(texCoord, texture(depthSampler, texCoord).r);
+    vec3 normal     = OctahedronDecode(texture(normalSampler, texCoord).xy);
+#else
+    vec3 fragPos    = texture(positionSampler, texCoord).xyz;
+    vec3 normal     = normalize(texture(normalSampler, texCoord).xyz);
+#endif
+    vec3 albedo     = texture(albedoSampler, texCoord).rgb;
+
+    PointLight light = lightBuffer.lights[lightIndex];
+    vec3 lightDir = normalize(light.position - fragPos);
+
+    // Diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+
+    // Attenuation, windowed to reach zero at the radius of the volume
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * (distance * distance));
+    float window = clamp(1.0 - pow(distance / light.radius, 4.0), 0.0, 1.0);
+    attenuation *= window * window;
+
+    // Has to match Lighting.frag, blended additively so the alpha stays as the ambient pass wrote it
+    outColor = vec4(light.color * diff * albedo * attenuation, 0.0f);
+}
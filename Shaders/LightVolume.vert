@@ -0,0 +1,37 @@
+#version 450
+
+struct PointLight
+{
+    vec3    position;
+    vec3    color;
+    float   radius;
+};
+
+layout(location = 0) flat out uint lightIndex;
+
+layout(std430, set = 1, binding = 1) readonly buffer LightBuffer
+{
+    PointLight lights[];
+} lightBuffer;
+
+layout(set = 2, binding = 0) uniform CameraBufferObject
+{
+    mat4 view;
+    mat4 proj;
+    mat4 projView;
+} cbo;
+
+// Unit sphere enclosing triangle list, see LightVolumeMesh
+layout(std430, set = 3, binding = 0) readonly buffer SphereBuffer
+{
+    vec4 vertices[];
+} sphereBuffer;
+
+void main()
+{
+    PointLight light = lightBuffer.lights[gl_InstanceIndex];
+    vec3 position = light.position + sphereBuffer.vertices[gl_VertexIndex].xyz * light.radius;
+
+    gl_Position = cbo.projView * vec4(position, 1.0);
+    lightIndex  = gl_InstanceIndex;
+}
@@ -1,6 +1,14 @@
 #version 450
 
-#define MAX_POINT_LIGHTS_SIZE 10
+// Has to match LightClusters.hpp
+#define CLUSTER_GRID_X          16
+#define CLUSTER_GRID_Y          9
+#define CLUSTER_GRID_Z          24
+#define CLUSTER_COUNT           (CLUSTER_GRID_X * CLUSTER_GRID_Y * CLUSTER_GRID_Z)
+#define MAX_LIGHTS_PER_CLUSTER  128
+
+// Has to match Ambient.frag
+#define AMBIENT 0.01f
 
 struct PointLight
 {
@@ -13,51 +21,106 @@ layout(location = 0) in vec2 fragTexCoord;
 
 layout(location = 0) out vec4 outColor;
 
+// Compiled once more with COMPACT_GBUFFER, which samples depth in place of the position target
 layout(set = 0, binding = 0) uniform sampler2D albedoSampler;
+#ifdef COMPACT_GBUFFER
+layout(set = 0, binding = 1) uniform sampler2D depthSampler;
+#else
 layout(set = 0, binding = 1) uniform sampler2D positionSampler;
+#endif
 layout(set = 0, binding = 2) uniform sampler2D normalSampler;
 
-layout(set = 0, binding = 3) uniform LightBuffer
+layout(set = 1, binding = 0) uniform ClusterParams
+{
+    mat4    viewMatrix;
+    mat4    inverseProjection;
+    vec2    screenSize;
+    float   nearPlane;
+    float   farPlane;
+    vec3    viewPos;
+    uint    lightCount;
+    mat4    inverseViewProjection;
+} params;
+
+layout(std430, set = 1, binding = 1) readonly buffer LightBuffer
 {
-    PointLight  lights[MAX_POINT_LIGHTS_SIZE];
-    int         numPointLights;
-    vec3        viewPos;
-    mat4        viewMatrix;
-} lbo;
+    PointLight lights[];
+} lightBuffer;
 
-vec4 CalculatePointLight(PointLight light);
+// Written by LightCulling.comp this frame
+layout(std430, set = 1, binding = 2) readonly buffer ClusterBuffer
+{
+    uint counts[CLUSTER_COUNT];
+    uint indices[];
+} clusterBuffer;
 
-void main()
+vec3 CalculatePointLight(PointLight light, vec3 fragPos, vec3 normal, vec3 albedo);
+
+#ifdef COMPACT_GBUFFER
+// Has to match OctahedronEncode in Geometry.frag
+vec3 OctahedronDecode(vec2 encoded)
+{
+    vec2 folded = encoded * 2.0 - 1.0;
+    vec3 normal = vec3(folded, 1.0 - abs(folded.x) - abs(folded.y));
+    float fold  = clamp(-normal.z, 0.0, 1.0);
+    normal.xy  += mix(vec2(fold), vec2(-fold), greaterThanEqual(normal.xy, vec2(0.0)));
+    return normalize(normal);
+}
+
+vec3 ReconstructPosition(vec2 texCoord, float depth)
 {
-    vec4 result = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    vec4 position = params.inverseViewProjection * vec4(texCoord * 2.0 - 1.0, depth, 1.0);
+    return position.xyz / position.w;
+}
+#endif
 
-    for(int i = 0; i < lbo.numPointLights; i++)
+void main()
+{
+    vec3 albedo     = texture(albedoSampler, fragTexCoord).rgb;
+#ifdef COMPACT_GBUFFER
+    // Nothing was drawn where the cleared depth is left
+    float gbufferDepth = texture(depthSampler, fragTexCoord).r;
+    if(gbufferDepth >= 1.0)
+    {
+        outColor = vec4(AMBIENT * albedo, 1.0f);
+        return;
+    }
+    vec3 fragPos    = ReconstructPosition(gl_FragCoord.xy / params.screenSize, gbufferDepth);
+    vec3 normal     = OctahedronDecode(texture(normalSampler, fragTexCoord).xy);
+#else
+    vec3 fragPos    = texture(positionSampler, fragTexCoord).xyz;
+    vec3 normal     = normalize(texture(normalSampler, fragTexCoord).xyz);
+#endif
+
+    // Same exponential slices as LightCulling.comp
+    float depth = max(-(params.viewMatrix * vec4(fragPos, 1.0)).z, params.nearPlane);
+    uint slice  = min(uint(log(depth / params.nearPlane) / log(params.farPlane / params.nearPlane) * float(CLUSTER_GRID_Z)), uint(CLUSTER_GRID_Z - 1));
+    uvec2 tile  = min(uvec2(gl_FragCoord.xy / params.screenSize * vec2(CLUSTER_GRID_X, CLUSTER_GRID_Y)), uvec2(CLUSTER_GRID_X - 1, CLUSTER_GRID_Y - 1));
+    uint cluster = tile.x + tile.y * CLUSTER_GRID_X + slice * CLUSTER_GRID_X * CLUSTER_GRID_Y;
+
+    vec3 result = AMBIENT * albedo;
+    uint count = clusterBuffer.counts[cluster];
+    for(uint i = 0; i < count; i++)
     {
-        result += CalculatePointLight(lbo.lights[i]);
+        result += CalculatePointLight(lightBuffer.lights[clusterBuffer.indices[cluster * MAX_LIGHTS_PER_CLUSTER + i]], fragPos, normal, albedo);
     }
 
-    outColor = result;
+    outColor = vec4(result, 1.0f);
 }
 
-vec4 CalculatePointLight(PointLight light)
+vec3 CalculatePointLight(PointLight light, vec3 fragPos, vec3 normal, vec3 albedo)
 {
-    vec3 fragPos = texture(positionSampler, fragTexCoord).xyz;
     vec3 lightDir = normalize(light.position - fragPos);
-    vec3 normal = normalize(texture(normalSampler, fragTexCoord)).xyz;
 
     // Diffuse shading
     float diff = max(dot(normal, lightDir), 0.0);
 
-    // Attenuation
+    // Attenuation, windowed to reach zero at the radius the light was clustered with
     float distance = length(light.position - fragPos);
     float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * (distance * distance));
+    float window = clamp(1.0 - pow(distance / light.radius, 4.0), 0.0, 1.0);
+    attenuation *= window * window;
 
-    // Combine results
-    vec3 ambient = vec3(0.01f, 0.01f, 0.01f) * vec3(texture(albedoSampler, fragTexCoord));
-    vec3 diffuse = light.color * diff * vec3(texture(albedoSampler, fragTexCoord));
-
-    ambient *= attenuation;
-    diffuse *= attenuation;
-
-    return vec4((ambient + diffuse), 1.0f);
-}
\ No newline at end of file
+    // Has to match LightVolume.frag and ComputeLighting.comp
+    return light.color * diff * albedo * attenuation;
+}
@@ -7,12 +7,14 @@
 #include "glm/glm.hpp"
 
 AssetManager::AssetManager(Context *context)
-    :   m_Context{context}
+    :   m_Context{context}, m_GeometryArena{context}, m_MaterialTable{context}
 {
 }
 
 void AssetManager::LoadMesh(std::string_view name, std::string_view path)
 {
+    CN_PROFILE_ZONE_DETAIL("LoadMesh", path);
+
     if(m_Meshes.contains(name.data()))
     {
         return;
@@ -31,28 +33,48 @@ void AssetManager::LoadMesh(std::string_view name, std::string_view path)
 
     if (parseResult == cgltf_result_success && validateResult == cgltf_result_success)
     {
-        mesh->m_SubMeshes.reserve(GetSubMeshCount(data));
+        size_t subMeshCount = GetSubMeshCount(data);
+        mesh->m_SubMeshes.reserve(subMeshCount);
         LoadBuffers(gltfPath, data);
+
+        // All primitives are gathered first so the whole mesh is uploaded into the arena with a single copy
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<SubMesh::MeshInfo> meshInfos;
+        meshInfos.reserve(subMeshCount);
+
         for(size_t i = 0; i < data->meshes_count; i++)
         {
             for(size_t j = 0; j < data->meshes[i].primitives_count; j++)
             {
-                std::vector<Vertex> vertices;
-                std::vector<uint32_t> indices;
+                size_t firstVertex  = vertices.size();
+                size_t firstIndex   = indices.size();
 
-                LoadVertices(&data->meshes[i].primitives[j], vertices);
+                Bounds::BoundingVolume bounds = LoadVertices(&data->meshes[i].primitives[j], vertices);
                 LoadIndices(&data->meshes[i].primitives[j], indices);
-                Material* material = LoadMaterial(name, &data->meshes[i].primitives[j]);
 
                 SubMesh::MeshInfo meshInfo{};
-                meshInfo.vertices   = vertices;
-                meshInfo.indices    = indices;
-                meshInfo.material   = material;
-
-                mesh->m_SubMeshes.emplace_back(m_Context, meshInfo);
+                meshInfo.geometry.vertexOffset  = static_cast<int32_t>(firstVertex);
+                meshInfo.geometry.firstIndex    = static_cast<uint32_t>(firstIndex);
+                meshInfo.geometry.vertexCount   = static_cast<uint32_t>(vertices.size() - firstVertex);
+                meshInfo.geometry.indexCount    = static_cast<uint32_t>(indices.size() - firstIndex);
+                meshInfo.material               = LoadMaterial(name, &data->meshes[i].primitives[j]);
+                meshInfo.bounds                 = bounds;
+                meshInfos.push_back(meshInfo);
             }
         }
 
+        GeometryArena::Range meshRange = m_GeometryArena.Upload(vertices, indices);
+        for(SubMesh::MeshInfo& meshInfo : meshInfos)
+        {
+            meshInfo.geometry.block         = meshRange.block;
+            meshInfo.geometry.vertexOffset += meshRange.vertexOffset;
+            meshInfo.geometry.firstIndex   += meshRange.firstIndex;
+
+            mesh->m_SubMeshes.emplace_back(meshInfo);
+        }
+        mesh->UpdateBounds();
+
         cgltf_free(data);
     }
 
@@ -79,33 +101,51 @@ void AssetManager::LoadBuffers(std::string_view path, cgltf_data* data)
     cgltf_load_buffers(&options, data, path.data());
 }
 
-void AssetManager::LoadVertices(cgltf_primitive* primitive, std::vector<Vertex>& vertices)
+Bounds::BoundingVolume AssetManager::LoadVertices(cgltf_primitive* primitive, std::vector<Vertex>& vertices)
 {
+    // Empty primitives get a degenerate volume at the origin rather than an inverted one
+    Bounds::BoundingVolume bounds{};
     if(primitive->attributes_count == 0)
     {
-        return;
+        return bounds;
     }
 
+    // Appends, so several primitives can share one vertex array
+    size_t firstVertex = vertices.size();
     size_t vertexCount = primitive->attributes[0].data->count;
-    vertices.resize(vertexCount);
+    vertices.resize(firstVertex + vertexCount);
 
     for(size_t i = 0; i < primitive->attributes_count; i++)
     {
         if(std::strcmp(primitive->attributes[i].name, "POSITION") == 0)
         {
+            // Unpacked in one go instead of a component type lookup per element
+            const cgltf_accessor* accessor = primitive->attributes[i].data;
+            m_PositionScratch.resize(vertexCount * 3);
+            cgltf_accessor_unpack_floats(accessor, m_PositionScratch.data(), m_PositionScratch.size());
+
             for(size_t j = 0; j < vertexCount; j++)
             {
-                cgltf_float position[3];
-                cgltf_accessor_read_float(primitive->attributes[i].data, j, position, sizeof(position));
-                vertices[j].pos = glm::vec3(position[0], position[1], position[2]);
+                vertices[firstVertex + j].pos = glm::vec3(m_PositionScratch[j * 3], m_PositionScratch[j * 3 + 1], m_PositionScratch[j * 3 + 2]);
             }
+
+            // glTF requires min and max on positions, exporters that skip them still get a reduction over the data
+            if(accessor->has_min && accessor->has_max)
+            {
+                bounds.aabb.min = glm::vec3(accessor->min[0], accessor->min[1], accessor->min[2]);
+                bounds.aabb.max = glm::vec3(accessor->max[0], accessor->max[1], accessor->max[2]);
+            } else
+            {
+                bounds.aabb = Bounds::ComputeAABB(m_PositionScratch);
+            }
+            bounds.sphere = Bounds::ComputeSphere(bounds.aabb, m_PositionScratch);
         } else if(std::strcmp(primitive->attributes[i].name, "NORMAL") == 0)
         {
             for(size_t j = 0; j < vertexCount; j++)
             {
                 cgltf_float normal[3];
                 cgltf_accessor_read_float(primitive->attributes[i].data, j, normal, sizeof(normal));
-                vertices[j].normal = glm::vec3(normal[0], normal[1], normal[2]);
+                vertices[firstVertex + j].normal = glm::vec3(normal[0], normal[1], normal[2]);
             }
         } else if(std::strcmp(primitive->attributes[i].name, "TANGENT") == 0)
         {
@@ -113,7 +153,7 @@ void AssetManager::LoadVertices(cgltf_primitive* primitive, std::vector<Vertex>&
             {
                 cgltf_float tangent[4];
                 cgltf_accessor_read_float(primitive->attributes[i].data, j, tangent, sizeof(tangent));
-                vertices[j].tangent = glm::vec4(tangent[0], tangent[1], tangent[2], tangent[3]);
+                vertices[firstVertex + j].tangent = glm::vec4(tangent[0], tangent[1], tangent[2], tangent[3]);
             }
         }
         else if(std::strcmp(primitive->attributes[i].name, "TEXCOORD_0") == 0)
@@ -122,10 +162,12 @@ void AssetManager::LoadVertices(cgltf_primitive* primitive, std::vector<Vertex>&
             {
                 cgltf_float texCoord[2];
                 cgltf_accessor_read_float(primitive->attributes[i].data, j, texCoord, sizeof(texCoord));
-                vertices[j].texCoord = glm::vec2(texCoord[0], texCoord[1]);
+                vertices[firstVertex + j].texCoord = glm::vec2(texCoord[0], texCoord[1]);
             }
         }
     }
+
+    return bounds;
 }
 
 void AssetManager::LoadIndices(cgltf_primitive* primitive, std::vector<uint32_t>& indices)
@@ -136,7 +178,6 @@ void AssetManager::LoadIndices(cgltf_primitive* primitive, std::vector<uint32_t>
     }
 
     size_t indicesCount = primitive->indices->count;
-    indices.reserve(indicesCount);
 
     for(size_t i = 0; i < indicesCount; i++)
     {
@@ -209,20 +250,31 @@ Material* AssetManager::LoadMaterial(std::string_view meshName, cgltf_primitive*
     matInfo.normal              = normalTexture;
     matInfo.metallicRoughness   = metallicRoughnessTexture;
     matInfo.materialObject      = matObject;
+    matInfo.index               = static_cast<uint32_t>(m_Materials.size());
 
-    m_Materials[matInfo.name] = std::make_unique<Material>(m_Context, matInfo);
+    matInfo.materialObject.albedoTexture            = albedoTexture->GetBindlessIndex();
+    matInfo.materialObject.normalTexture            = normalTexture->GetBindlessIndex();
+    matInfo.materialObject.metallicRoughnessTexture = metallicRoughnessTexture->GetBindlessIndex();
+
+    m_MaterialTable.SetMaterial(matInfo.index, matInfo.materialObject);
+    m_Materials[matInfo.name] = std::make_unique<Material>(matInfo);
 
     return m_Materials.at(matInfo.name).get();
 }
 
 Texture* AssetManager::LoadTexture(std::string_view name, std::string_view path)
 {
+    CN_PROFILE_ZONE_DETAIL("LoadTexture", path);
+
     if(m_Textures.contains(name.data()))
     {
         return m_Textures.at(name.data()).get();
     }
 
-    m_Textures[name.data()] = std::make_unique<Texture>(m_Context, name, path);
+    std::unique_ptr<Texture> texture = std::make_unique<Texture>(m_Context, name, path);
+    texture->SetBindlessIndex(m_MaterialTable.AddTexture(*texture));
+
+    m_Textures[name.data()] = std::move(texture);
     return m_Textures.at(name.data()).get();
 }
 
@@ -232,7 +284,10 @@ Texture* AssetManager::LoadDefaultTexture()
     {
         std::filesystem::path cwd = std::filesystem::current_path().parent_path();
         std::string fullPath = cwd.string() + "/Assets/Textures/Black.jpeg";
-        m_Textures["DefaultTexture"] = std::make_unique<Texture>(m_Context, "DefaultTexture", fullPath);
+        std::unique_ptr<Texture> texture = std::make_unique<Texture>(m_Context, "DefaultTexture", fullPath);
+        texture->SetBindlessIndex(m_MaterialTable.AddTexture(*texture));
+
+        m_Textures["DefaultTexture"] = std::move(texture);
     }
 
     return m_Textures.at("DefaultTexture").get();
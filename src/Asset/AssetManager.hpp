@@ -3,6 +3,8 @@
 #include "Mesh.hpp"
 #include "Texture.hpp"
 #include "Material.hpp"
+#include "MaterialTable.hpp"
+#include "Renderer/Buffer/GeometryArena.hpp"
 
 struct cgltf_data;
 struct cgltf_primitive;
@@ -20,17 +22,25 @@ public:
 public:
     void LoadMesh(std::string_view name, std::string_view path);
     Mesh* GetMesh(std::string_view name);
+public:
+    inline const GeometryArena& GetGeometryArena() const { return m_GeometryArena; }
+    inline const MaterialTable& GetMaterialTable() const { return m_MaterialTable; }
 private:
     size_t GetSubMeshCount(cgltf_data* data);
     void LoadBuffers(std::string_view path, cgltf_data* data);
-    void LoadVertices(cgltf_primitive* primitive, std::vector<Vertex>& vertices);
+    // Returns the model space bounds of the primitive's positions
+    Bounds::BoundingVolume LoadVertices(cgltf_primitive* primitive, std::vector<Vertex>& vertices);
     void LoadIndices(cgltf_primitive* primitive, std::vector<uint32_t>& indices);
     Material* LoadMaterial(std::string_view meshName, cgltf_primitive* primitive);
     Texture* LoadTexture(std::string_view name, std::string_view path);
     Texture* LoadDefaultTexture();
 private:
     Context*                                                    m_Context;
+    GeometryArena                                               m_GeometryArena;
+    MaterialTable                                               m_MaterialTable;
     std::unordered_map<std::string, std::unique_ptr<Mesh>>      m_Meshes;
     std::unordered_map<std::string, std::unique_ptr<Texture>>   m_Textures;
     std::unordered_map<std::string, std::unique_ptr<Material>>  m_Materials;
+    // Reused by every primitive so loading does not allocate per attribute
+    std::vector<float>                                          m_PositionScratch;
 };
\ No newline at end of file
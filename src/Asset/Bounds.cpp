@@ -0,0 +1,83 @@
+#include "Core/CnPch.hpp"
+#include "Bounds.hpp"
+
+#include <algorithm>
+
+namespace Bounds
+{
+    AABB ComputeAABB(std::span<const float> positions)
+    {
+        if(positions.size() < 3)
+        {
+            return AABB{};
+        }
+
+        // Straight over the unpacked floats, no glm temporaries per vertex
+        float minX = positions[0], minY = positions[1], minZ = positions[2];
+        float maxX = minX, maxY = minY, maxZ = minZ;
+        for(size_t i = 3; i + 2 < positions.size(); i += 3)
+        {
+            minX = std::min(minX, positions[i]);
+            minY = std::min(minY, positions[i + 1]);
+            minZ = std::min(minZ, positions[i + 2]);
+            maxX = std::max(maxX, positions[i]);
+            maxY = std::max(maxY, positions[i + 1]);
+            maxZ = std::max(maxZ, positions[i + 2]);
+        }
+
+        return { glm::vec3(minX, minY, minZ), glm::vec3(maxX, maxY, maxZ) };
+    }
+
+    Sphere ComputeSphere(const AABB& aabb, std::span<const float> positions)
+    {
+        glm::vec3 center = aabb.GetCenter();
+
+        float radiusSquared = 0.0f;
+        for(size_t i = 0; i + 2 < positions.size(); i += 3)
+        {
+            glm::vec3 offset = glm::vec3(positions[i], positions[i + 1], positions[i + 2]) - center;
+            radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+        }
+
+        return { center, std::sqrt(radiusSquared) };
+    }
+
+    BoundingVolume Merge(const BoundingVolume& a, const BoundingVolume& b)
+    {
+        BoundingVolume merged{};
+        merged.aabb.min = glm::min(a.aabb.min, b.aabb.min);
+        merged.aabb.max = glm::max(a.aabb.max, b.aabb.max);
+
+        // Around the merged box, large enough to hold both spheres
+        merged.sphere.center = merged.aabb.GetCenter();
+        merged.sphere.radius = std::max(glm::length(a.sphere.center - merged.sphere.center) + a.sphere.radius,
+                                        glm::length(b.sphere.center - merged.sphere.center) + b.sphere.radius);
+
+        return merged;
+    }
+
+    BoundingVolume Transform(const BoundingVolume& volume, const glm::mat4& matrix)
+    {
+        glm::mat3 linear = glm::mat3(matrix);
+
+        // Arvo's method, the new extent is the absolute linear part applied to the old one
+        glm::mat3 absLinear{};
+        for(int i = 0; i < 3; i++)
+        {
+            absLinear[i] = glm::abs(linear[i]);
+        }
+        glm::vec3 center = glm::vec3(matrix * glm::vec4(volume.aabb.GetCenter(), 1.0f));
+        glm::vec3 extent = absLinear * volume.aabb.GetExtent();
+
+        // Non uniform scale stretches the sphere by its largest axis
+        float maxScale = std::max(glm::length(linear[0]), std::max(glm::length(linear[1]), glm::length(linear[2])));
+
+        BoundingVolume transformed{};
+        transformed.aabb.min        = center - extent;
+        transformed.aabb.max        = center + extent;
+        transformed.sphere.center   = glm::vec3(matrix * glm::vec4(volume.sphere.center, 1.0f));
+        transformed.sphere.radius   = volume.sphere.radius * maxScale;
+
+        return transformed;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "glm/glm.hpp"
+
+namespace Bounds
+{
+    struct AABB
+    {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+
+        inline glm::vec3 GetCenter() const { return (min + max) * 0.5f; }
+        inline glm::vec3 GetExtent() const { return (max - min) * 0.5f; }
+    };
+
+    struct Sphere
+    {
+        glm::vec3   center{0.0f};
+        float       radius{0.0f};
+    };
+
+    // The box is the tighter fit, the sphere the cheaper test
+    struct BoundingVolume
+    {
+        AABB    aabb;
+        Sphere  sphere;
+    };
+
+    // Positions are tightly packed xyz triples, as unpacked from a glTF accessor
+    AABB ComputeAABB(std::span<const float> positions);
+    // Centered on the box, sized by the farthest position so it is never looser than the box's circumsphere
+    Sphere ComputeSphere(const AABB& aabb, std::span<const float> positions);
+
+    BoundingVolume Merge(const BoundingVolume& a, const BoundingVolume& b);
+    // Conservative for any affine transform, the box stays axis aligned in the new space
+    BoundingVolume Transform(const BoundingVolume& volume, const glm::mat4& matrix);
+}
@@ -2,18 +2,24 @@
 
 #include "glm/glm.hpp"
 
-class Context;
 class Texture;
 
 class Material
 {
 public:
+    // Matches MaterialObject in Geometry.frag (std430), one entry per material in the material table
     struct MaterialObject
     {
         glm::vec4   albedoColor{1.0f};
         float       metallicFactor{1.0f};
         float       roughnessFactor{1.0f};
+        uint32_t    albedoTexture{0};
+        uint32_t    normalTexture{0};
+        uint32_t    metallicRoughnessTexture{0};
+        uint32_t    padding[3]{};
     };
+    // The material table is indexed with the std430 array stride of MaterialObject
+    static_assert(sizeof(MaterialObject) == 48, "MaterialObject has to match the std430 layout in Geometry.frag");
     struct MaterialInfo
     {
         std::string     name;
@@ -21,32 +27,22 @@ public:
         Texture*        normal;
         Texture*        metallicRoughness;
         MaterialObject  materialObject;
+        uint32_t        index;          // Dense, in creation order, slot in the material table
     };
 public:
-    Material(Context* context, const MaterialInfo& matInfo);
-    ~Material();
+    explicit Material(const MaterialInfo& matInfo);
+    ~Material() = default;
 
     Material(const Material& otherMaterial) = delete;
     Material& operator=(const Material& otherMaterial) = delete;
 public:
-    inline VkDescriptorSet GetDescriptorSet() const { return m_DescriptorSet; }
-    inline VkDescriptorSetLayout GetLayout() const { return m_DescriptorSetLayout; }
     inline const MaterialObject& GetMaterialObject() const { return m_MaterialObject; }
+    inline uint32_t GetIndex() const { return m_Index; }
 private:
-    void CreateDescriptorPool();
-    void CreateDescriptorSet();
-    void SetSamplerData();
-private:
-    const uint32_t textureCount = 3;
-private:
-    Context*                m_Context;
     std::string             m_Name;
     Texture*                m_AlbedoTexture;
     Texture*                m_NormalTexture;
     Texture*                m_MetallicRoughness;
     MaterialObject          m_MaterialObject;
-private:
-    VkDescriptorSet         m_DescriptorSet;
-    VkDescriptorPool        m_DescriptorPool;
-    VkDescriptorSetLayout   m_DescriptorSetLayout;
-};
\ No newline at end of file
+    uint32_t                m_Index;
+};
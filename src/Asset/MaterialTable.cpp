@@ -0,0 +1,146 @@
+#include "Core/CnPch.hpp"
+#include "MaterialTable.hpp"
+
+#include "Renderer/Context.hpp"
+#include "Texture.hpp"
+
+MaterialTable::MaterialTable(Context* context)
+    :   m_Context{context}, m_DescriptorPool{}, m_DescriptorSetLayout{}, m_DescriptorSet{}, m_TextureCount{0}
+{
+    CreateDescriptorPool();
+    CreateDescriptorSet();
+    CreateMaterialBuffer();
+}
+
+void MaterialTable::CreateDescriptorPool()
+{
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+    poolSizes[0].type               = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSizes[0].descriptorCount    = MAX_TEXTURES;
+    poolSizes[1].type               = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[1].descriptorCount    = 1;
+
+    VkDescriptorPoolCreateInfo poolCreateInfo{};
+    poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolCreateInfo.flags            = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolCreateInfo.maxSets          = 1;
+    poolCreateInfo.poolSizeCount    = static_cast<uint32_t>(poolSizes.size());
+    poolCreateInfo.pPoolSizes       = poolSizes.data();
+
+    VK_CHECK(vkCreateDescriptorPool(m_Context->GetLogicalDevice(), &poolCreateInfo, nullptr, &m_DescriptorPool))
+}
+
+void MaterialTable::CreateDescriptorSet()
+{
+    std::array<VkDescriptorSetLayoutBinding, 2> layoutBindings{};
+    layoutBindings[0].binding           = 0;
+    layoutBindings[0].descriptorType    = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    layoutBindings[0].descriptorCount   = MAX_TEXTURES;
+    layoutBindings[0].stageFlags        = VK_SHADER_STAGE_FRAGMENT_BIT;
+    layoutBindings[1].binding           = 1;
+    layoutBindings[1].descriptorType    = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    layoutBindings[1].descriptorCount   = 1;
+    layoutBindings[1].stageFlags        = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    // Textures can be added while earlier frames that never sample the new slots are still in flight
+    std::array<VkDescriptorBindingFlags, 2> bindingFlags{};
+    bindingFlags[0] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+    bindingFlags[1] = 0;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+    bindingFlagsInfo.sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsInfo.bindingCount   = static_cast<uint32_t>(bindingFlags.size());
+    bindingFlagsInfo.pBindingFlags  = bindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext        = &bindingFlagsInfo;
+    layoutInfo.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+    layoutInfo.pBindings    = layoutBindings.data();
+
+    VK_CHECK(vkCreateDescriptorSetLayout(m_Context->GetLogicalDevice(), &layoutInfo, nullptr, &m_DescriptorSetLayout))
+
+    VkDescriptorSetAllocateInfo setAllocateInfo{};
+    setAllocateInfo.sType               = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    setAllocateInfo.descriptorPool      = m_DescriptorPool;
+    setAllocateInfo.descriptorSetCount  = 1;
+    setAllocateInfo.pSetLayouts         = &m_DescriptorSetLayout;
+
+    VK_CHECK(vkAllocateDescriptorSets(m_Context->GetLogicalDevice(), &setAllocateInfo, &m_DescriptorSet))
+}
+
+void MaterialTable::CreateMaterialBuffer()
+{
+    Buffer::BufferInfo bufferInfo{};
+    bufferInfo.size             = MAX_MATERIALS * sizeof(Material::MaterialObject);
+    bufferInfo.usageFlags       = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    bufferInfo.vmaMemoryUsage   = VMA_MEMORY_USAGE_AUTO;
+    bufferInfo.vmaAllocFlags    = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    m_MaterialBuffer = std::make_unique<Buffer>(m_Context, bufferInfo);
+
+    VkDescriptorBufferInfo materialBufferInfo{};
+    materialBufferInfo.buffer   = m_MaterialBuffer->GetBuffer();
+    materialBufferInfo.offset   = 0;
+    materialBufferInfo.range    = VK_WHOLE_SIZE;
+
+    VkWriteDescriptorSet writeSet{};
+    writeSet.sType              = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeSet.dstSet             = m_DescriptorSet;
+    writeSet.dstBinding         = 1;
+    writeSet.dstArrayElement    = 0;
+    writeSet.descriptorCount    = 1;
+    writeSet.descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writeSet.pBufferInfo        = &materialBufferInfo;
+
+    vkUpdateDescriptorSets(m_Context->GetLogicalDevice(), 1, &writeSet, 0, nullptr);
+}
+
+uint32_t MaterialTable::AddTexture(const Texture& texture)
+{
+    if(m_TextureCount >= MAX_TEXTURES)
+    {
+        throw std::runtime_error("Error: Bindless texture table is full.");
+    }
+
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.sampler       = texture.GetSampler();
+    imageInfo.imageView     = texture.GetImage()->GetImageView();
+    imageInfo.imageLayout   = texture.GetImage()->GetImageLayout();
+
+    VkWriteDescriptorSet writeSet{};
+    writeSet.sType              = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeSet.dstSet             = m_DescriptorSet;
+    writeSet.dstBinding         = 0;
+    writeSet.dstArrayElement    = m_TextureCount;
+    writeSet.descriptorCount    = 1;
+    writeSet.descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    writeSet.pImageInfo         = &imageInfo;
+
+    vkUpdateDescriptorSets(m_Context->GetLogicalDevice(), 1, &writeSet, 0, nullptr);
+
+    return m_TextureCount++;
+}
+
+void MaterialTable::SetMaterial(uint32_t materialIndex, const Material::MaterialObject& materialObject)
+{
+    if(materialIndex >= MAX_MATERIALS)
+    {
+        throw std::runtime_error("Error: Material table is full.");
+    }
+
+    m_MaterialBuffer->Map(&materialObject, sizeof(Material::MaterialObject), materialIndex * sizeof(Material::MaterialObject));
+}
+
+MaterialTable::~MaterialTable()
+{
+    if(m_DescriptorSetLayout)
+    {
+        vkDestroyDescriptorSetLayout(m_Context->GetLogicalDevice(), m_DescriptorSetLayout, nullptr);
+    }
+    if(m_DescriptorPool)
+    {
+        vkDestroyDescriptorPool(m_Context->GetLogicalDevice(), m_DescriptorPool, nullptr);
+    }
+}
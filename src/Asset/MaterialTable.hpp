@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Material.hpp"
+#include "Renderer/Buffer/Buffer.hpp"
+
+class Context;
+class Texture;
+
+// Global bindless descriptor set shared by every material: all textures in one partially bound sampler array
+// (binding 0) and all material parameters in one storage buffer (binding 1). Bound once per frame.
+class MaterialTable
+{
+public:
+    explicit MaterialTable(Context* context);
+    ~MaterialTable();
+
+    MaterialTable(const MaterialTable& otherTable) = delete;
+    MaterialTable& operator=(const MaterialTable& otherTable) = delete;
+public:
+    // Returns the slot of the texture in the sampler array
+    uint32_t AddTexture(const Texture& texture);
+    void SetMaterial(uint32_t materialIndex, const Material::MaterialObject& materialObject);
+public:
+    inline VkDescriptorSet GetDescriptorSet() const { return m_DescriptorSet; }
+    inline VkDescriptorSetLayout GetDescriptorSetLayout() const { return m_DescriptorSetLayout; }
+    inline uint32_t GetTextureCount() const { return m_TextureCount; }
+    inline static constexpr uint32_t MAX_TEXTURES = 1024;
+    inline static constexpr uint32_t MAX_MATERIALS = 1024;
+private:
+    void CreateDescriptorPool();
+    void CreateDescriptorSet();
+    void CreateMaterialBuffer();
+private:
+    Context*                m_Context;
+    VkDescriptorPool        m_DescriptorPool;
+    VkDescriptorSetLayout   m_DescriptorSetLayout;
+    VkDescriptorSet         m_DescriptorSet;
+    std::unique_ptr<Buffer> m_MaterialBuffer;
+    uint32_t                m_TextureCount;
+};
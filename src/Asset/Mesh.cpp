@@ -2,6 +2,21 @@
 #include "Mesh.hpp"
 
 Mesh::Mesh(std::string_view name, std::string_view path)
-        :   m_Name{name.data()}, m_FilePath{path.data()}
+        :   m_Name{name.data()}, m_FilePath{path.data()}, m_Bounds{}
 {
+}
+
+void Mesh::UpdateBounds()
+{
+    if(m_SubMeshes.empty())
+    {
+        m_Bounds = Bounds::BoundingVolume{};
+        return;
+    }
+
+    m_Bounds = m_SubMeshes.front().GetBounds();
+    for(size_t i = 1; i < m_SubMeshes.size(); i++)
+    {
+        m_Bounds = Bounds::Merge(m_Bounds, m_SubMeshes[i].GetBounds());
+    }
 }
\ No newline at end of file
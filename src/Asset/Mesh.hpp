@@ -12,9 +12,13 @@ public:
     Mesh& operator=(const Mesh& otherMesh) = delete;
 public:
     const std::string& GetName() const { return m_Name; }
+    // Model space bounds of all submeshes
+    inline const Bounds::BoundingVolume& GetBounds() const { return m_Bounds; }
+    void UpdateBounds();
 public:
     std::vector<SubMesh>    m_SubMeshes;
 private:
     std::string             m_Name;
     std::string             m_FilePath;
+    Bounds::BoundingVolume  m_Bounds;
 };
\ No newline at end of file
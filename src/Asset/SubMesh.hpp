@@ -1,9 +1,8 @@
 #pragma once
 
-#include "Renderer/Buffer/VertexBuffer.hpp"
-#include "Renderer/Buffer/IndexBuffer.hpp"
+#include "Renderer/Buffer/GeometryArena.hpp"
+#include "Bounds.hpp"
 
-class Context;
 class Material;
 
 class SubMesh
@@ -11,12 +10,13 @@ class SubMesh
 public:
     struct MeshInfo
     {
-        std::vector<Vertex>     vertices;
-        std::vector<uint32_t>   indices;
+        GeometryArena::Range    geometry;
         Material*               material;
+        // Model space bounds of the submesh's vertices
+        Bounds::BoundingVolume  bounds;
     };
 public:
-    SubMesh(Context* context, const MeshInfo& meshInfo);
+    explicit SubMesh(const MeshInfo& meshInfo);
     ~SubMesh() = default;
 
     SubMesh(SubMesh&& otherSubMesh) = default;
@@ -24,12 +24,13 @@ public:
     SubMesh(const SubMesh& otherMesh) = delete;
     SubMesh& operator=(const SubMesh& otherMesh) = delete;
 public:
-    inline const VertexBuffer& GetVertexBuffer() const { return m_VertexBuffer; }
-    inline const IndexBuffer& GetIndexBuffer() const { return m_IndexBuffer; }
+    // Where the vertices and indices live inside the geometry arena
+    inline const GeometryArena::Range& GetGeometry() const { return m_Geometry; }
+    inline uint32_t GetIndexCount() const { return m_Geometry.indexCount; }
     inline const Material* GetMaterial() const { return m_Material; }
+    inline const Bounds::BoundingVolume& GetBounds() const { return m_Bounds; }
 private:
-    Context*        m_Context;
-    Material*       m_Material;
-    VertexBuffer    m_VertexBuffer;
-    IndexBuffer     m_IndexBuffer;
+    Material*               m_Material;
+    GeometryArena::Range    m_Geometry;
+    Bounds::BoundingVolume  m_Bounds;
 };
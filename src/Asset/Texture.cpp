@@ -7,7 +7,7 @@
 #include "stb/stb_image.h"
 
 Texture::Texture(Context* context, std::string_view name, std::string_view path)
-    :   m_Context{context}, m_Name{name.data()}, m_FilePath{path.data()}, m_Sampler{}, m_TextureInfo{}
+    :   m_Context{context}, m_Name{name.data()}, m_FilePath{path.data()}, m_Sampler{}, m_TextureInfo{}, m_BindlessIndex{0}
 {
     CreateImage(m_FilePath);
     CreateSampler();
@@ -23,6 +23,8 @@ public:
 public:
     inline VkSampler GetSampler() const { return m_Sampler; }
     inline const Image* GetImage() const { return m_Image.get(); }
+    inline uint32_t GetBindlessIndex() const { return m_BindlessIndex; }
+    inline void SetBindlessIndex(uint32_t bindlessIndex) { m_BindlessIndex = bindlessIndex; }
 private:
     void CreateImage(const std::string& path);
     void CreateSampler();
@@ -34,4 +36,5 @@ private:
     std::unique_ptr<Image>  m_Image;
     VkSampler               m_Sampler;
     TextureInfo             m_TextureInfo;
+    uint32_t                m_BindlessIndex;
 };
\ No newline at end of file
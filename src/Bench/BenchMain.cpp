@@ -0,0 +1,85 @@
+#include "Core/CnPch.hpp"
+#include "Bench/ConeBench.hpp"
+
+int main(int argc, char** argv)
+{
+    ConeBench::BenchInfo benchInfo{};
+
+    // --frames N measured frames, --warmup N unmeasured frames first, --csv/--json <file> results, --trace <file> CPU trace,
+    // --direct-draw compares against one draw call per submesh, --no-culling against drawing every submesh,
+    // --no-occlusion against frustum culling alone, --no-cpu-culling against unculled direct draws,
+    // --no-depth-sort against material order, --no-parallel-recording against recording direct draws on one thread,
+    // --point-lights N adds N small point lights to the scene, --light-volumes compares light volumes against light clusters,
+    // --compute-lighting compares the tiled compute lighting pass against the full screen fragment pass,
+    // --compact-gbuffer and --compact-hdr compare the packed G-buffer and B10G11R11 HDR target against the wide formats,
+    // --depth-prepass <off|on|auto> compares the G-buffer GPU time with and without the depth pre-pass
+    for(int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+        if(arg == "--frames" && i + 1 < argc)
+        {
+            benchInfo.frameCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if(arg == "--warmup" && i + 1 < argc)
+        {
+            benchInfo.warmupFrames = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if(arg == "--width" && i + 1 < argc)
+        {
+            benchInfo.extent.width = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if(arg == "--height" && i + 1 < argc)
+        {
+            benchInfo.extent.height = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if(arg == "--csv" && i + 1 < argc)
+        {
+            benchInfo.csvPath = argv[++i];
+        } else if(arg == "--json" && i + 1 < argc)
+        {
+            benchInfo.jsonPath = argv[++i];
+        } else if(arg == "--trace" && i + 1 < argc)
+        {
+            benchInfo.tracePath = argv[++i];
+        } else if(arg == "--direct-draw")
+        {
+            benchInfo.indirectDraw = false;
+        } else if(arg == "--no-depth-sort")
+        {
+            benchInfo.frontToBack = false;
+        } else if(arg == "--no-culling")
+        {
+            benchInfo.gpuCulling = false;
+            benchInfo.cpuCulling = false;
+        } else if(arg == "--no-occlusion")
+        {
+            benchInfo.occlusionCulling = false;
+        } else if(arg == "--no-cpu-culling")
+        {
+            benchInfo.cpuCulling = false;
+        } else if(arg == "--no-parallel-recording")
+        {
+            benchInfo.parallelRecording = false;
+        } else if(arg == "--point-lights" && i + 1 < argc)
+        {
+            benchInfo.pointLightCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if(arg == "--light-volumes")
+        {
+            benchInfo.lightVolumes = true;
+        } else if(arg == "--compute-lighting")
+        {
+            benchInfo.computeLighting = true;
+        } else if(arg == "--compact-gbuffer")
+        {
+            benchInfo.compactGBuffer = true;
+        } else if(arg == "--compact-hdr")
+        {
+            benchInfo.compactHDR = true;
+        } else if(arg == "--depth-prepass" && i + 1 < argc)
+        {
+            std::string_view mode = argv[++i];
+            benchInfo.depthPrepass = mode == "on" ? Renderer::DepthPrepassMode::On : mode == "auto" ? Renderer::DepthPrepassMode::Auto : Renderer::DepthPrepassMode::Off;
+        }
+    }
+
+    ConeBench bench{benchInfo};
+    bench.Run();
+
+    return 0;
+}
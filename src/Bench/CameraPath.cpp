@@ -0,0 +1,64 @@
+#include "Core/CnPch.hpp"
+#include "CameraPath.hpp"
+
+#include <algorithm>
+
+CameraPath::CameraPath(std::vector<glm::vec3> controlPoints)
+    :   m_ControlPoints{std::move(controlPoints)}
+{
+    if(m_ControlPoints.size() < 4)
+    {
+        throw std::runtime_error("Error: A camera path needs at least four control points.");
+    }
+}
+
+glm::vec3 CameraPath::GetPosition(float t) const
+{
+    size_t count        = m_ControlPoints.size();
+    float scaled        = (t - std::floor(t)) * static_cast<float>(count);
+    size_t segment      = std::min(static_cast<size_t>(scaled), count - 1);
+    float local         = scaled - static_cast<float>(segment);
+
+    const glm::vec3& p0 = m_ControlPoints[(segment + count - 1) % count];
+    const glm::vec3& p1 = m_ControlPoints[segment];
+    const glm::vec3& p2 = m_ControlPoints[(segment + 1) % count];
+    const glm::vec3& p3 = m_ControlPoints[(segment + 2) % count];
+
+    float local2 = local * local;
+    float local3 = local2 * local;
+
+    return 0.5f * ((2.0f * p1) +
+                   (-p0 + p2) * local +
+                   (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * local2 +
+                   (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * local3);
+}
+
+CameraPath::Pose CameraPath::Evaluate(float t) const
+{
+    // Looks at a point slightly ahead on the path, pitched down a little so the floor stays in view
+    constexpr float LOOK_AHEAD = 0.01f;
+
+    glm::vec3 position  = GetPosition(t);
+    glm::vec3 direction = GetPosition(t + LOOK_AHEAD) - position;
+    direction.y        -= 0.15f * glm::length(direction);
+
+    if(glm::length(direction) < 1e-5f)
+    {
+        direction = glm::vec3(0.0f, 0.0f, -1.0f);
+    }
+
+    return { position, glm::normalize(direction) };
+}
+
+CameraPath CameraPath::CreateMainScenePath()
+{
+    return CameraPath({
+        glm::vec3(-10.0f, 1.0f, -1.0f),
+        glm::vec3( -3.0f, 1.5f, -0.2f),
+        glm::vec3(  4.0f, 1.0f, -1.8f),
+        glm::vec3( 10.0f, 2.0f, -1.0f),
+        glm::vec3(  4.0f, 4.5f,  1.5f),
+        glm::vec3( -3.0f, 4.5f, -3.5f),
+        glm::vec3( -8.0f, 2.0f, -1.3f)
+    });
+}
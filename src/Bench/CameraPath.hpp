@@ -0,0 +1,26 @@
+#pragma once
+
+#include "glm/glm.hpp"
+
+// Closed Catmull-Rom spline through fixed control points, evaluated from the frame index alone so runs are repeatable
+class CameraPath
+{
+public:
+    struct Pose
+    {
+        glm::vec3 position;
+        glm::vec3 direction;
+    };
+public:
+    explicit CameraPath(std::vector<glm::vec3> controlPoints);
+    ~CameraPath() = default;
+public:
+    // t in [0, 1) covers the whole loop
+    Pose Evaluate(float t) const;
+    glm::vec3 GetPosition(float t) const;
+public:
+    // Walks the nave of the main scene and circles back past the point light
+    static CameraPath CreateMainScenePath();
+private:
+    std::vector<glm::vec3> m_ControlPoints;
+};
@@ -0,0 +1,406 @@
+#include "Core/CnPch.hpp"
+#include "ConeBench.hpp"
+
+#include "Core/Cone.hpp"
+#include "Core/AllocationCounter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+ConeBench::ConeBench(const BenchInfo& benchInfo)
+    :   m_Info{benchInfo}, m_CameraPath{CameraPath::CreateMainScenePath()}
+{
+    if(m_Info.frameCount == 0)
+    {
+        throw std::runtime_error("Error: The benchmark needs at least one measured frame.");
+    }
+}
+
+void ConeBench::Init()
+{
+    CN_PROFILE_FUNCTION();
+
+    std::chrono::steady_clock::time_point loadStart = std::chrono::steady_clock::now();
+
+    // No window, so there is no swapchain and nothing throttles the frame rate to vsync
+    m_JobSystem     = std::make_unique<JobSystem>(JobSystem::GetDefaultWorkerCount());
+    m_Context       = std::make_unique<Context>(nullptr, m_Info.extent);
+    m_AssetManager  = std::make_unique<AssetManager>(m_Context.get());
+    m_Scene         = Cone::LoadMainScene(m_Context.get(), m_AssetManager.get(), m_Info.pointLightCount);
+
+    Renderer::RendererInfo rendererInfo{};
+    rendererInfo.compactGBuffer  = m_Info.compactGBuffer;
+    rendererInfo.compactHDR      = m_Info.compactHDR;
+    rendererInfo.lightVolumes    = m_Info.lightVolumes;
+    rendererInfo.computeLighting = m_Info.computeLighting;
+    rendererInfo.depthPrepass    = m_Info.depthPrepass;
+
+    m_Renderer      = std::make_unique<Renderer>(m_Context.get(), m_AssetManager.get(), m_Scene.get(), m_JobSystem.get(), rendererInfo);
+    m_Renderer->SetActiveScene(m_Scene.get());
+    m_Renderer->SetIndirectDrawing(m_Info.indirectDraw);
+    m_Renderer->SetFrontToBack(m_Info.frontToBack);
+    m_Renderer->SetGpuCulling(m_Info.gpuCulling);
+    m_Renderer->SetOcclusionCulling(m_Info.occlusionCulling);
+    m_Renderer->SetCpuCulling(m_Info.cpuCulling);
+    m_Renderer->SetParallelRecording(m_Info.parallelRecording);
+
+    vkDeviceWaitIdle(m_Context->GetLogicalDevice());
+    m_LoadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(m_Context->GetPhysicalDevice(), &properties);
+    m_DeviceName = properties.deviceName;
+
+    SampleMemoryUsage();
+
+    std::cout << "[Cone] Benchmark on " << m_DeviceName << ", " << m_Info.warmupFrames << " warmup and " << m_Info.frameCount << " measured frames at "
+              << m_Info.extent.width << "x" << m_Info.extent.height << " with " << m_Scene->GetPointLights().size() << " point lights" << std::endl;
+}
+
+void ConeBench::Run()
+{
+    Profiler::SetThreadName("Main");
+    if(!m_Info.tracePath.empty())
+    {
+        Profiler::Begin(m_Info.tracePath);
+    }
+
+    Init();
+
+    m_CpuFrameMs.reserve(m_Info.frameCount);
+    m_GpuFrameMs.reserve(m_Info.frameCount);
+    m_GpuGBufferMs.reserve(m_Info.frameCount);
+
+    uint32_t totalFrames = m_Info.warmupFrames + m_Info.frameCount;
+    for(uint32_t frame = 0; frame < totalFrames; frame++)
+    {
+        RenderFrame(frame);
+    }
+
+    vkDeviceWaitIdle(m_Context->GetLogicalDevice());
+    Profiler::End();
+
+    Report();
+    if(!m_Info.csvPath.empty())
+    {
+        WriteCsv(m_Info.csvPath);
+    }
+    if(!m_Info.jsonPath.empty())
+    {
+        WriteJson(m_Info.jsonPath);
+    }
+}
+
+void ConeBench::RenderFrame(uint32_t frame)
+{
+    CN_PROFILE_ZONE("Frame");
+
+    std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+    uint64_t allocationsBefore = AllocationCounter::GetCount();
+
+    // The pose depends on the frame number only, the path is looped once over the measured frames
+    float t = static_cast<float>(frame) / static_cast<float>(m_Info.frameCount);
+    CameraPath::Pose pose = m_CameraPath.Evaluate(t);
+
+    Camera& camera = m_Scene->GetCamera();
+    camera.SetPose(pose.position, pose.direction);
+    camera.Update();
+
+    // Extracted and drawn on this thread, so the renderer statistics below are never read mid-frame
+    m_Packet.Extract(*m_Scene);
+    m_Renderer->DrawFrame(m_Packet);
+
+    // Taken before the bookkeeping below, a steady state frame should not allocate at all
+    uint64_t allocations = AllocationCounter::GetCount() - allocationsBefore;
+    double cpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+    bool measured = frame >= m_Info.warmupFrames;
+    if(measured)
+    {
+        m_CpuFrameMs.push_back(cpuMs);
+
+        // Like the GPU timings these belong to the frame that last used this slot
+        const SceneDrawList::CullingStats& cullingStats = m_Renderer->GetCullingStats();
+        m_CullingTotals.drawCount                   += cullingStats.drawCount;
+        m_CullingTotals.triangleCount               += cullingStats.triangleCount;
+        m_CullingTotals.frustumCulledDraws          += cullingStats.frustumCulledDraws;
+        m_CullingTotals.frustumCulledTriangles      += cullingStats.frustumCulledTriangles;
+        m_CullingTotals.occlusionCulledDraws        += cullingStats.occlusionCulledDraws;
+        m_CullingTotals.occlusionCulledTriangles    += cullingStats.occlusionCulledTriangles;
+        m_CullingTotals.sampleCount++;
+
+        const CommandRecorder::Stats& commandStats = m_Renderer->GetCommandStats();
+        m_IssuedCommands += commandStats.GetIssued();
+        m_ElidedCommands += commandStats.GetElided();
+
+        m_Allocations += allocations;
+        m_AllocatingFrames += allocations > 0 ? 1U : 0U;
+    }
+
+    // Results trail by the frames in flight, a new sample shows up once the frame's slot was reused
+    const GpuProfiler& gpuProfiler = m_Renderer->GetGpuProfiler();
+    if(gpuProfiler.IsSupported() && !gpuProfiler.GetStats().empty())
+    {
+        const GpuProfiler::ScopeStats& frameStats = gpuProfiler.GetStats().front();
+        if(frameStats.sampleCount != m_LastGpuSampleCount)
+        {
+            m_LastGpuSampleCount = frameStats.sampleCount;
+
+            // Scopes are read back together with the frame scope, the pre-pass one only on frames that used it
+            const GpuProfiler::ScopeStats* prepassStats = gpuProfiler.FindStats("DepthPrepass");
+            const bool prepassSampled = prepassStats && prepassStats->sampleCount != m_LastPrepassSampleCount;
+            if(prepassSampled)
+            {
+                m_LastPrepassSampleCount = prepassStats->sampleCount;
+            }
+
+            if(measured)
+            {
+                m_GpuFrameMs.push_back(frameStats.lastMs);
+
+                const GpuProfiler::ScopeStats* geometryStats = gpuProfiler.FindStats("Geometry");
+                if(geometryStats)
+                {
+                    m_GpuGBufferMs.push_back((prepassSampled ? prepassStats->lastMs : 0.0) + geometryStats->lastMs);
+                }
+            }
+        }
+    }
+
+    SampleMemoryUsage();
+}
+
+void ConeBench::SampleMemoryUsage()
+{
+    const VkPhysicalDeviceMemoryProperties* memoryProperties = nullptr;
+    vmaGetMemoryProperties(m_Context->GetAllocator(), &memoryProperties);
+
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets{};
+    vmaGetHeapBudgets(m_Context->GetAllocator(), budgets.data());
+
+    uint64_t deviceMemory = 0;
+    for(uint32_t i = 0; i < memoryProperties->memoryHeapCount; i++)
+    {
+        if(memoryProperties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+        {
+            deviceMemory += budgets[i].usage;
+        }
+    }
+
+    m_PeakDeviceMemory = std::max(m_PeakDeviceMemory, deviceMemory);
+}
+
+ConeBench::FrameTimeStats ConeBench::ComputeStats(std::vector<double> samples)
+{
+    FrameTimeStats stats{};
+    if(samples.empty())
+    {
+        return stats;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    // Nearest rank, the same definition the GPU profiler uses for its p99
+    auto percentile = [&samples](double p)
+    {
+        size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(samples.size())));
+        return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+    };
+
+    double sum = 0.0;
+    for(double sample : samples)
+    {
+        sum += sample;
+    }
+
+    stats.p50Ms         = percentile(0.50);
+    stats.p95Ms         = percentile(0.95);
+    stats.p99Ms         = percentile(0.99);
+    stats.avgMs         = sum / static_cast<double>(samples.size());
+    stats.minMs         = samples.front();
+    stats.maxMs         = samples.back();
+    stats.sampleCount   = samples.size();
+
+    return stats;
+}
+
+const char* ConeBench::GetDepthPrepassName(Renderer::DepthPrepassMode mode)
+{
+    switch(mode)
+    {
+        case Renderer::DepthPrepassMode::Off:
+            return "off";
+        case Renderer::DepthPrepassMode::On:
+            return "on";
+        case Renderer::DepthPrepassMode::Auto:
+            return "auto";
+    }
+
+    return "off";
+}
+
+ConeBench::CullingTotals ConeBench::ComputeCullingAverages() const
+{
+    CullingTotals averages = m_CullingTotals;
+    if(averages.sampleCount == 0)
+    {
+        return averages;
+    }
+
+    double count = static_cast<double>(averages.sampleCount);
+    averages.drawCount                  /= count;
+    averages.triangleCount              /= count;
+    averages.frustumCulledDraws         /= count;
+    averages.frustumCulledTriangles     /= count;
+    averages.occlusionCulledDraws       /= count;
+    averages.occlusionCulledTriangles   /= count;
+
+    return averages;
+}
+
+void ConeBench::Report() const
+{
+    FrameTimeStats cpuStats     = ComputeStats(m_CpuFrameMs);
+    FrameTimeStats gpuStats     = ComputeStats(m_GpuFrameMs);
+    FrameTimeStats gbufferStats = ComputeStats(m_GpuGBufferMs);
+    CullingTotals culling       = ComputeCullingAverages();
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "[Cone] Load " << m_LoadMs << " ms, peak device memory " << static_cast<double>(m_PeakDeviceMemory) / (1024.0 * 1024.0) << " MB\n"
+              << "[Cone] CPU frame p50 " << cpuStats.p50Ms << " ms, p95 " << cpuStats.p95Ms << " ms, p99 " << cpuStats.p99Ms << " ms\n"
+              << "[Cone] GPU frame p50 " << gpuStats.p50Ms << " ms, p95 " << gpuStats.p95Ms << " ms, p99 " << gpuStats.p99Ms << " ms ("
+              << gpuStats.sampleCount << " samples)\n"
+              << "[Cone] GPU G-buffer p50 " << gbufferStats.p50Ms << " ms, p95 " << gbufferStats.p95Ms << " ms, p99 " << gbufferStats.p99Ms
+              << " ms with the depth pre-pass " << GetDepthPrepassName(m_Info.depthPrepass) << "\n"
+              << "[Cone] Culled per frame: " << culling.frustumCulledDraws << " draws / " << culling.frustumCulledTriangles << " triangles by the frustum, "
+              << culling.occlusionCulledDraws << " draws / " << culling.occlusionCulledTriangles << " triangles by occlusion, of "
+              << culling.drawCount << " draws / " << culling.triangleCount << " triangles\n"
+              << "[Cone] State changes per frame: " << static_cast<double>(m_IssuedCommands) / static_cast<double>(m_Info.frameCount) << " issued, "
+              << static_cast<double>(m_ElidedCommands) / static_cast<double>(m_Info.frameCount) << " elided" << std::endl;
+    if(AllocationCounter::IsEnabled())
+    {
+        std::cout << "[Cone] Heap allocations per frame: " << static_cast<double>(m_Allocations) / static_cast<double>(m_Info.frameCount)
+                  << " (" << m_AllocatingFrames << " of " << m_Info.frameCount << " frames allocated)" << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+void ConeBench::WriteCsv(const std::string& path) const
+{
+    std::ofstream file(path);
+    if(!file.is_open())
+    {
+        throw std::runtime_error("Error: Failed to open benchmark output " + path);
+    }
+
+    FrameTimeStats cpuStats     = ComputeStats(m_CpuFrameMs);
+    FrameTimeStats gpuStats     = ComputeStats(m_GpuFrameMs);
+    FrameTimeStats gbufferStats = ComputeStats(m_GpuGBufferMs);
+    CullingTotals culling       = ComputeCullingAverages();
+
+    // One metric per row so runs can be joined on the metric column
+    file << std::fixed << std::setprecision(4);
+    file << "metric,value\n"
+         << "frames," << m_Info.frameCount << "\n"
+         << "point_lights," << m_Scene->GetPointLights().size() << "\n"
+         << "light_volumes," << (m_Info.lightVolumes ? 1 : 0) << "\n"
+         << "compute_lighting," << (m_Info.computeLighting ? 1 : 0) << "\n"
+         << "compact_gbuffer," << (m_Info.compactGBuffer ? 1 : 0) << "\n"
+         << "compact_hdr," << (m_Info.compactHDR ? 1 : 0) << "\n"
+         << "depth_prepass," << GetDepthPrepassName(m_Info.depthPrepass) << "\n"
+         << "load_ms," << m_LoadMs << "\n"
+         << "peak_vram_mb," << static_cast<double>(m_PeakDeviceMemory) / (1024.0 * 1024.0) << "\n"
+         << "cpu_frame_p50_ms," << cpuStats.p50Ms << "\n"
+         << "cpu_frame_p95_ms," << cpuStats.p95Ms << "\n"
+         << "cpu_frame_p99_ms," << cpuStats.p99Ms << "\n"
+         << "cpu_frame_avg_ms," << cpuStats.avgMs << "\n"
+         << "gpu_frame_p50_ms," << gpuStats.p50Ms << "\n"
+         << "gpu_frame_p95_ms," << gpuStats.p95Ms << "\n"
+         << "gpu_frame_p99_ms," << gpuStats.p99Ms << "\n"
+         << "gpu_frame_avg_ms," << gpuStats.avgMs << "\n"
+         << "gpu_gbuffer_p50_ms," << gbufferStats.p50Ms << "\n"
+         << "gpu_gbuffer_p95_ms," << gbufferStats.p95Ms << "\n"
+         << "gpu_gbuffer_p99_ms," << gbufferStats.p99Ms << "\n"
+         << "gpu_gbuffer_avg_ms," << gbufferStats.avgMs << "\n"
+         << "draws," << culling.drawCount << "\n"
+         << "triangles," << culling.triangleCount << "\n"
+         << "frustum_culled_draws," << culling.frustumCulledDraws << "\n"
+         << "frustum_culled_triangles," << culling.frustumCulledTriangles << "\n"
+         << "occlusion_culled_draws," << culling.occlusionCulledDraws << "\n"
+         << "occlusion_culled_triangles," << culling.occlusionCulledTriangles << "\n"
+         << "state_changes_issued," << static_cast<double>(m_IssuedCommands) / static_cast<double>(m_Info.frameCount) << "\n"
+         << "state_changes_elided," << static_cast<double>(m_ElidedCommands) / static_cast<double>(m_Info.frameCount) << "\n";
+    if(AllocationCounter::IsEnabled())
+    {
+        file << "allocations," << static_cast<double>(m_Allocations) / static_cast<double>(m_Info.frameCount) << "\n"
+             << "allocating_frames," << m_AllocatingFrames << "\n";
+    }
+
+    std::cout << "[Cone] Benchmark results written to " << path << std::endl;
+}
+
+void ConeBench::WriteJson(const std::string& path) const
+{
+    std::ofstream file(path);
+    if(!file.is_open())
+    {
+        throw std::runtime_error("Error: Failed to open benchmark output " + path);
+    }
+
+    auto writeStats = [&file](const char* name, const FrameTimeStats& stats)
+    {
+        file << "  \"" << name << "\": { \"p50\": " << stats.p50Ms << ", \"p95\": " << stats.p95Ms << ", \"p99\": " << stats.p99Ms
+             << ", \"avg\": " << stats.avgMs << ", \"min\": " << stats.minMs << ", \"max\": " << stats.maxMs << ", \"samples\": " << stats.sampleCount << " }";
+    };
+
+    // Device names are plain ASCII, quotes and backslashes are the only characters that would need escaping
+    std::string deviceName;
+    for(char character : m_DeviceName)
+    {
+        if(character == '"' || character == '\\')
+        {
+            deviceName += '\\';
+        }
+        deviceName += character;
+    }
+
+    file << std::fixed << std::setprecision(4);
+    file << "{\n"
+         << "  \"scene\": \"Sponza\",\n"
+         << "  \"device\": \"" << deviceName << "\",\n"
+         << "  \"width\": " << m_Info.extent.width << ",\n"
+         << "  \"height\": " << m_Info.extent.height << ",\n"
+         << "  \"frames\": " << m_Info.frameCount << ",\n"
+         << "  \"pointLights\": " << m_Scene->GetPointLights().size() << ",\n"
+         << "  \"lightVolumes\": " << (m_Info.lightVolumes ? "true" : "false") << ",\n"
+         << "  \"computeLighting\": " << (m_Info.computeLighting ? "true" : "false") << ",\n"
+         << "  \"compactGBuffer\": " << (m_Info.compactGBuffer ? "true" : "false") << ",\n"
+         << "  \"compactHdr\": " << (m_Info.compactHDR ? "true" : "false") << ",\n"
+         << "  \"depthPrepass\": \"" << GetDepthPrepassName(m_Info.depthPrepass) << "\",\n"
+         << "  \"warmupFrames\": " << m_Info.warmupFrames << ",\n"
+         << "  \"loadMs\": " << m_LoadMs << ",\n"
+         << "  \"peakVramMb\": " << static_cast<double>(m_PeakDeviceMemory) / (1024.0 * 1024.0) << ",\n";
+    writeStats("cpuFrameMs", ComputeStats(m_CpuFrameMs));
+    file << ",\n";
+    writeStats("gpuFrameMs", ComputeStats(m_GpuFrameMs));
+    file << ",\n";
+    writeStats("gpuGBufferMs", ComputeStats(m_GpuGBufferMs));
+
+    CullingTotals culling = ComputeCullingAverages();
+    file << ",\n"
+         << "  \"culling\": { \"draws\": " << culling.drawCount << ", \"triangles\": " << culling.triangleCount
+         << ", \"frustumCulledDraws\": " << culling.frustumCulledDraws << ", \"frustumCulledTriangles\": " << culling.frustumCulledTriangles
+         << ", \"occlusionCulledDraws\": " << culling.occlusionCulledDraws << ", \"occlusionCulledTriangles\": " << culling.occlusionCulledTriangles << " }";
+    file << ",\n"
+         << "  \"stateChanges\": { \"issued\": " << static_cast<double>(m_IssuedCommands) / static_cast<double>(m_Info.frameCount)
+         << ", \"elided\": " << static_cast<double>(m_ElidedCommands) / static_cast<double>(m_Info.frameCount) << " }";
+    if(AllocationCounter::IsEnabled())
+    {
+        file << ",\n"
+             << "  \"allocations\": { \"perFrame\": " << static_cast<double>(m_Allocations) / static_cast<double>(m_Info.frameCount)
+             << ", \"allocatingFrames\": " << m_AllocatingFrames << " }";
+    }
+    file << "\n}\n";
+
+    std::cout << "[Cone] Benchmark results written to " << path << std::endl;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Renderer/Context.hpp"
+#include "Renderer/Renderer.hpp"
+#include "Scene/Scene.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Core/JobSystem.hpp"
+#include "CameraPath.hpp"
+
+// Renders the main scene headless along a fixed camera path and reports frame time percentiles
+class ConeBench
+{
+public:
+    struct BenchInfo
+    {
+        VkExtent2D  extent{1920, 1080};
+        uint32_t    frameCount{1000};
+        uint32_t    warmupFrames{60};   // Rendered first and left out of the statistics
+        std::string csvPath;
+        std::string jsonPath;
+        std::string tracePath;
+        bool        indirectDraw{true};
+        bool        frontToBack{true};
+        bool        gpuCulling{true};
+        bool        occlusionCulling{true};
+        bool        cpuCulling{true};
+        bool        parallelRecording{true};
+        uint32_t    pointLightCount{0};
+        bool        lightVolumes{false};
+        bool        computeLighting{false};
+        bool        compactGBuffer{false};
+        bool        compactHDR{false};
+        Renderer::DepthPrepassMode  depthPrepass{Renderer::DepthPrepassMode::Off};
+    };
+    struct FrameTimeStats
+    {
+        double      p50Ms{0.0};
+        double      p95Ms{0.0};
+        double      p99Ms{0.0};
+        double      avgMs{0.0};
+        double      minMs{0.0};
+        double      maxMs{0.0};
+        size_t      sampleCount{0};
+    };
+    // Per frame averages of the culling counters over the measured frames
+    struct CullingTotals
+    {
+        double      drawCount{0.0};
+        double      triangleCount{0.0};
+        double      frustumCulledDraws{0.0};
+        double      frustumCulledTriangles{0.0};
+        double      occlusionCulledDraws{0.0};
+        double      occlusionCulledTriangles{0.0};
+        size_t      sampleCount{0};
+    };
+public:
+    explicit ConeBench(const BenchInfo& benchInfo);
+    ~ConeBench() = default;
+
+    ConeBench(const ConeBench& otherBench) = delete;
+    ConeBench& operator=(const ConeBench& otherBench) = delete;
+public:
+    void Run();
+private:
+    void Init();
+    void RenderFrame(uint32_t frame);
+    void SampleMemoryUsage();
+    void Report() const;
+    void WriteCsv(const std::string& path) const;
+    void WriteJson(const std::string& path) const;
+    static FrameTimeStats ComputeStats(std::vector<double> samples);
+    static const char* GetDepthPrepassName(Renderer::DepthPrepassMode mode);
+    CullingTotals ComputeCullingAverages() const;
+private:
+    BenchInfo                       m_Info;
+    CameraPath                      m_CameraPath;
+    std::string                     m_DeviceName;
+    double                          m_LoadMs{0.0};
+    uint64_t                        m_PeakDeviceMemory{0};
+    uint32_t                        m_LastGpuSampleCount{0};
+    uint32_t                        m_LastPrepassSampleCount{0};
+    std::vector<double>             m_CpuFrameMs;
+    std::vector<double>             m_GpuFrameMs;
+    // Depth pre-pass plus early geometry pass, the part of the frame the pre-pass mode changes
+    std::vector<double>             m_GpuGBufferMs;
+    CullingTotals                   m_CullingTotals;
+    // State changes over the measured frames, as counted by the command recorder
+    uint64_t                        m_IssuedCommands{0};
+    uint64_t                        m_ElidedCommands{0};
+    // Heap allocations over the measured frames, only counted in CONE_COUNT_ALLOCATIONS builds
+    uint64_t                        m_Allocations{0};
+    uint32_t                        m_AllocatingFrames{0};
+    std::unique_ptr<JobSystem>      m_JobSystem;
+    std::unique_ptr<Context>        m_Context;
+    std::unique_ptr<AssetManager>   m_AssetManager;
+    std::unique_ptr<Renderer>       m_Renderer;
+    std::unique_ptr<Scene>          m_Scene;
+    RenderPacket                    m_Packet;
+};
@@ -0,0 +1,89 @@
+#include "Core/CnPch.hpp"
+#include "Renderer/FrustumCuller.hpp"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iterator>
+#include <random>
+
+// Times FrustumCuller on random boxes without a device, every compiled path against the scalar one
+int main(int argc, char** argv)
+{
+    uint32_t boxCount   = 100000;
+    uint32_t iterations = 200;
+
+    // --count N boxes, --iterations N timed culls per path
+    for(int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+        if(arg == "--count" && i + 1 < argc)
+        {
+            boxCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if(arg == "--iterations" && i + 1 < argc)
+        {
+            iterations = std::max(1U, static_cast<uint32_t>(std::stoul(argv[++i])));
+        }
+    }
+
+    // Fixed seed so every run culls the same scene, spread so roughly a third of the boxes end up visible
+    std::mt19937 generator{1337};
+    std::uniform_real_distribution<float> position{-100.0f, 100.0f};
+    std::uniform_real_distribution<float> size{0.1f, 2.0f};
+
+    FrustumCuller culler;
+    culler.Reserve(boxCount);
+    for(uint32_t i = 0; i < boxCount; i++)
+    {
+        glm::vec3 center = glm::vec3(position(generator), position(generator), position(generator));
+        glm::vec3 extent = glm::vec3(size(generator), size(generator), size(generator));
+        culler.Add({ center - extent, center + extent });
+    }
+
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 viewProjection = projection * view;
+
+    std::vector<uint32_t> reference;
+    culler.Cull(viewProjection, reference, FrustumCuller::Path::Scalar);
+
+    std::cout << "[Cone] Culling " << boxCount << " boxes, " << reference.size() << " visible, " << iterations << " iterations" << std::endl;
+
+    std::vector<uint32_t> visible;
+    for(FrustumCuller::Path path : { FrustumCuller::Path::Scalar, FrustumCuller::Path::SSE, FrustumCuller::Path::AVX })
+    {
+        // Paths this binary was not compiled for fall back to scalar, timing them again says nothing
+        if(path != FrustumCuller::Path::Scalar && static_cast<int>(path) > static_cast<int>(FrustumCuller::GetBestPath()))
+        {
+            continue;
+        }
+
+        double totalMs = 0.0;
+        double bestMs = std::numeric_limits<double>::max();
+        for(uint32_t i = 0; i < iterations; i++)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            culler.Cull(viewProjection, visible, path);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            totalMs += ms;
+            bestMs = std::min(bestMs, ms);
+        }
+
+        // Contracted multiply-adds can still round a box touching a plane differently, so only report it
+        std::vector<uint32_t> mismatches;
+        std::set_symmetric_difference(visible.begin(), visible.end(), reference.begin(), reference.end(), std::back_inserter(mismatches));
+        if(!mismatches.empty())
+        {
+            std::cout << "[Cone] " << FrustumCuller::GetPathName(path) << " disagrees with the scalar path on " << mismatches.size() << " boxes" << std::endl;
+        }
+
+        std::cout << std::fixed << std::setprecision(4)
+                  << "[Cone] " << FrustumCuller::GetPathName(path) << " avg " << totalMs / static_cast<double>(iterations) << " ms, best " << bestMs << " ms" << std::endl;
+        std::cout << std::defaultfloat;
+    }
+
+    return 0;
+}
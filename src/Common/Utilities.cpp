@@ -80,4 +80,104 @@ namespace Utilities
                 1, &barrier
         );
     }
+
+    ImageSyncState GetImageSyncState(VkImageLayout layout)
+    {
+        switch(layout)
+        {
+            case VK_IMAGE_LAYOUT_UNDEFINED:
+                return { layout, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE };
+            case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+                return { layout, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT };
+            case VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL:
+                return { layout, VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                         VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT };
+            case VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_OPTIMAL:
+                return { layout, VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                         VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT };
+            case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+                return { layout, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT };
+            case VK_IMAGE_LAYOUT_GENERAL:
+                return { layout, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT };
+            case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+                return { layout, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT };
+            case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+                return { layout, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT };
+            case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+                // Chains with the image available semaphore, which is waited on at colour output
+                return { layout, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE };
+            default:
+                throw std::invalid_argument("Error: This layout has no known synchronization scope!");
+        }
+    }
+
+    bool IsWriteAccess(VkAccessFlags2 accessMask)
+    {
+        constexpr VkAccessFlags2 writeAccesses =
+                VK_ACCESS_2_SHADER_WRITE_BIT |
+                VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+                VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                VK_ACCESS_2_TRANSFER_WRITE_BIT |
+                VK_ACCESS_2_HOST_WRITE_BIT |
+                VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+        return (accessMask & writeAccesses) != 0;
+    }
+
+    bool NeedsBarrier(const ImageSyncState& previousState, const ImageSyncState& nextState)
+    {
+        if(previousState.layout != nextState.layout)
+        {
+            return true;
+        }
+        if(IsWriteAccess(previousState.accessMask) || IsWriteAccess(nextState.accessMask))
+        {
+            return true;
+        }
+
+        // Nothing on the device has touched the image since it was last synchronized on the host
+        if(previousState.stageMask == VK_PIPELINE_STAGE_2_NONE)
+        {
+            return false;
+        }
+
+        // Read after read only needs a barrier when a new stage starts reading, so it is chained after the last write
+        return (nextState.stageMask & ~previousState.stageMask) != 0 || (nextState.accessMask & ~previousState.accessMask) != 0;
+    }
+
+    std::vector<char> ReadShaderCode(std::string_view path)
+    {
+        std::filesystem::path cwd = std::filesystem::current_path().parent_path();
+        std::string fullPath = cwd.string() + std::string(path);
+        std::ifstream shaderFile(fullPath, std::ios::ate | std::ios::binary);
+
+        if(!shaderFile.is_open())
+        {
+            throw std::runtime_error("Error: Failed to open file " + fullPath);
+        }
+
+        std::streamsize fileSize = static_cast<std::streamsize>(shaderFile.tellg());
+        std::vector<char> buffer(fileSize);
+
+        shaderFile.seekg(0);
+        shaderFile.read(buffer.data(), fileSize);
+        shaderFile.close();
+
+        return buffer;
+    }
+
+    VkShaderModule CreateShaderModule(VkDevice device, std::span<const char> shaderCode)
+    {
+        VkShaderModuleCreateInfo moduleCreateInfo{};
+        moduleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleCreateInfo.codeSize = shaderCode.size();
+        moduleCreateInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
+
+        VkShaderModule shaderModule;
+
+        VK_CHECK(vkCreateShaderModule(device, &moduleCreateInfo, nullptr, &shaderModule))
+
+        return shaderModule;
+    }
 }
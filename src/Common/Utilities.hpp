@@ -23,5 +23,21 @@
         VkPipelineStageFlags    sourceStageFlags = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
     };
 
+    struct ImageSyncState
+    {
+        VkImageLayout           layout;
+        VkPipelineStageFlags2   stageMask;
+        VkAccessFlags2          accessMask;
+    };
+
     void ChangeLayout(VkCommandBuffer commandBuffer, const LayoutTransitionInfo& layoutTransitionInfo);
+
+    // Narrowest stage and access scope an image is used with in the given layout
+    ImageSyncState GetImageSyncState(VkImageLayout layout);
+    bool IsWriteAccess(VkAccessFlags2 accessMask);
+    bool NeedsBarrier(const ImageSyncState& previousState, const ImageSyncState& nextState);
+
+    // SPIR-V is loaded relative to the parent of the working directory, like every other asset
+    std::vector<char> ReadShaderCode(std::string_view path);
+    VkShaderModule CreateShaderModule(VkDevice device, std::span<const char> shaderCode);
  }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "Core/CnPch.hpp"
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef CN_COUNT_ALLOCATIONS
+
+namespace
+{
+    std::atomic<uint64_t> g_AllocationCount{0};
+
+    void* Allocate(std::size_t size, std::size_t alignment)
+    {
+        g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+        size = std::max<std::size_t>(size, 1);
+#ifdef _MSC_VER
+        void* pointer = _aligned_malloc(size, alignment);
+#else
+        // aligned_alloc wants the size to be a multiple of the alignment
+        void* pointer = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+        if(!pointer)
+        {
+            throw std::bad_alloc();
+        }
+        return pointer;
+    }
+
+    void Free(void* pointer)
+    {
+#ifdef _MSC_VER
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+// The array and nothrow forms forward to these two by default
+void* operator new(std::size_t size) { return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return Allocate(size, static_cast<std::size_t>(alignment)); }
+void operator delete(void* pointer) noexcept { Free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { Free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { Free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { Free(pointer); }
+
+bool AllocationCounter::IsEnabled()
+{
+    return true;
+}
+
+uint64_t AllocationCounter::GetCount()
+{
+    return g_AllocationCount.load(std::memory_order_relaxed);
+}
+
+#else
+
+bool AllocationCounter::IsEnabled()
+{
+    return false;
+}
+
+uint64_t AllocationCounter::GetCount()
+{
+    return 0;
+}
+
+#endif
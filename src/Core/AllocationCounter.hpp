@@ -0,0 +1,9 @@
+#pragma once
+
+// Counts calls to the global operator new on every thread, to confirm that steady state frames do not allocate.
+// Only compiled in with CONE_COUNT_ALLOCATIONS, otherwise the count stays at zero and IsEnabled is false.
+namespace AllocationCounter
+{
+    bool IsEnabled();
+    uint64_t GetCount();
+}
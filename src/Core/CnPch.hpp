@@ -1,7 +1,5 @@
 #pragma once
 
-#define MAX_POINT_LIGHTS_SIZE 10
-
 #define VK_NO_PROTOTYPES
 #include <volk.h>
 
@@ -22,9 +20,11 @@
 #include <filesystem>
 
 #include <memory>
+#include <memory_resource>
 #include <functional>
 #include <exception>
 
 #include <cmath>
 
-#include <Common/Utilities.hpp>
\ No newline at end of file
+#include <Common/Utilities.hpp>
+#include <Core/Profiler.hpp>
\ No newline at end of file
@@ -3,60 +3,151 @@
 
 #include "Asset/SubMesh.hpp"
 
+#include <random>
+
+Cone::Cone(const ConeInfo& coneInfo)
+    :   m_Info{coneInfo}
+{
+}
+
 void Cone::Init()
 {
-    VkExtent2D extent = {1920, 1080};
-    m_Window        = std::make_unique<Window>(extent, "Cone Engine");
-    m_Context       = std::make_unique<Context>(m_Window.get());
+    CN_PROFILE_FUNCTION();
+
+    if(!m_Info.headless)
+    {
+        m_Window = std::make_unique<Window>(m_Info.extent, "Cone Engine");
+    }
+    m_JobSystem     = std::make_unique<JobSystem>(JobSystem::GetDefaultWorkerCount());
+    m_Context       = std::make_unique<Context>(m_Window.get(), m_Info.extent);
     m_AssetManager  = std::make_unique<AssetManager>(m_Context.get());
 
     CreateMainScene();
-    m_Renderer = std::make_unique<Renderer>(m_Context.get(), m_MainScene.get());
+    Renderer::RendererInfo rendererInfo{};
+    rendererInfo.compactGBuffer  = m_Info.compactGBuffer;
+    rendererInfo.compactHDR      = m_Info.compactHDR;
+    rendererInfo.lightVolumes    = m_Info.lightVolumes;
+    rendererInfo.computeLighting = m_Info.computeLighting;
+    rendererInfo.depthPrepass    = m_Info.depthPrepass;
+
+    m_Renderer = std::make_unique<Renderer>(m_Context.get(), m_AssetManager.get(), m_MainScene.get(), m_JobSystem.get(), rendererInfo);
     m_Renderer->SetActiveScene(m_MainScene.get());
+    m_Renderer->SetIndirectDrawing(m_Info.indirectDraw);
+    m_Renderer->SetFrontToBack(m_Info.frontToBack);
+    m_Renderer->SetGpuCulling(m_Info.gpuCulling);
+    m_Renderer->SetOcclusionCulling(m_Info.occlusionCulling);
+    m_Renderer->SetCpuCulling(m_Info.cpuCulling);
+    m_Renderer->SetParallelRecording(m_Info.parallelRecording);
+
+    if(m_Info.renderThread)
+    {
+        m_RenderThread = std::make_unique<RenderThread>(m_Renderer.get());
+    }
 
-    glfwSetInputMode(m_Window->GetGLFWWindow(), GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-    glfwSetCursorPos(m_Window->GetGLFWWindow(), m_Window->GetWidth()/2, m_Window->GetHeight()/2);
+    if(m_Window)
+    {
+        glfwSetInputMode(m_Window->GetGLFWWindow(), GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+        glfwSetCursorPos(m_Window->GetGLFWWindow(), m_Window->GetWidth()/2, m_Window->GetHeight()/2);
+    }
 
-    std::cout << "[Cone] Successfully Initialized\n";
+    std::cout << "[Cone] Successfully Initialized" << (m_Info.headless ? " (Headless)\n" : "\n");
 }
 
 void Cone::Run()
 {
+    Profiler::SetThreadName("Main");
+    if(!m_Info.tracePath.empty())
+    {
+        Profiler::Begin(m_Info.tracePath);
+    }
+
     Init();
 
-    while(!m_Window->ShouldClose())
+    while(!ShouldClose())
     {
-        m_Window->PollEvents();
+        CN_PROFILE_ZONE("Frame");
+
+        if(m_Window)
+        {
+            m_Window->PollEvents();
 
-        m_MainScene->GetCamera().ProcessKeyboardInputs(m_Window->GetGLFWWindow());
-        m_MainScene->GetCamera().ProcessMouseMovements(m_Window->GetGLFWWindow());
-        m_MainScene->GetCamera().Update(m_Renderer->GetCurrentFrame());
+            m_MainScene->GetCamera().ProcessKeyboardInputs(m_Window->GetGLFWWindow());
+            m_MainScene->GetCamera().ProcessMouseMovements(m_Window->GetGLFWWindow());
+        }
+        m_MainScene->GetCamera().Update();
 
         UpdateMainScene();
 
         Draw();
+        m_FramesRendered++;
     }
 
+    if(m_RenderThread)
+    {
+        m_RenderThread->Stop();
+    }
     vkDeviceWaitIdle(m_Context->GetLogicalDevice());
+    Profiler::End();
     std::cout << "[Cone] Successfully Closed\n";
 }
 
 void Cone::Draw()
 {
-    m_Renderer->DrawFrame();
+    // Extraction ends the main thread's frame, from here on the scene can change again
+    if(m_RenderThread)
+    {
+        RenderPacket& packet = m_RenderThread->AcquirePacket();
+        packet.Extract(*m_MainScene);
+        m_RenderThread->Submit(packet);
+        return;
+    }
+
+    m_Packet.Extract(*m_MainScene);
+    m_Renderer->DrawFrame(m_Packet);
+}
+
+bool Cone::ShouldClose() const
+{
+    if(m_Info.frameCount != 0 && m_FramesRendered >= m_Info.frameCount)
+    {
+        return true;
+    }
+
+    return m_Window ? m_Window->ShouldClose() : false;
 }
 
 void Cone::CreateMainScene()
 {
-    m_MainScene = std::make_unique<Scene>(m_Context.get());
+    m_MainScene = LoadMainScene(m_Context.get(), m_AssetManager.get(), m_Info.pointLightCount);
+}
+
+std::unique_ptr<Scene> Cone::LoadMainScene(Context* context, AssetManager* assetManager, uint32_t pointLightCount)
+{
+    CN_PROFILE_FUNCTION();
+
+    std::unique_ptr<Scene> scene = std::make_unique<Scene>(context);
 
-    m_AssetManager->LoadMesh("Sponza", "/Assets/Models/Sponza/Sponza.gltf");
-    SceneMember* sponza = m_MainScene->AddSceneMember(m_AssetManager->GetMesh("Sponza"));
+    assetManager->LoadMesh("Sponza", "/Assets/Models/Sponza/Sponza.gltf");
+    SceneMember* sponza = scene->AddSceneMember(assetManager->GetMesh("Sponza"));
     sponza->Scale(0.01f, 0.01f, 0.01f).Translate(0.0f, -0.3f, -1.0f).UpdateModelMatrix();
 
-    m_MainScene->GetCamera().SetExposure(1.0f);
+    scene->GetCamera().SetExposure(1.0f);
+
+    scene->AddPointLight({ glm::vec3(-7.66f, 1.95f, -1.32f), glm::vec3(0.6f, 0.6f, 0.6f), 10.0f });
+
+    // Small lights scattered through the atrium, seeded so every run places them the same
+    std::mt19937 random(1337U);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for(uint32_t i = 0; i < pointLightCount; i++)
+    {
+        Lights::PointLight pointLight{};
+        pointLight.position = glm::vec3(-12.0f + 24.0f * unit(random), 8.0f * unit(random), -6.0f + 10.0f * unit(random));
+        pointLight.color    = glm::vec3(0.2f + 0.8f * unit(random), 0.2f + 0.8f * unit(random), 0.2f + 0.8f * unit(random));
+        pointLight.radius   = 1.0f + unit(random);
+        scene->AddPointLight(pointLight);
+    }
 
-    m_MainScene->AddPointLight({ glm::vec3(-7.66f, 1.95f, -1.32f), glm::vec3(0.6f, 0.6f, 0.6f), 10.0f });
+    return scene;
 }
 
 void Cone::UpdateMainScene()
@@ -3,26 +3,59 @@
 #include "Renderer/Window.hpp"
 #include "Renderer/Context.hpp"
 #include "Renderer/Renderer.hpp"
+#include "Renderer/RenderThread.hpp"
 #include "Scene/Scene.hpp"
 #include "Scene/SceneMember.hpp"
 #include "Asset/AssetManager.hpp"
+#include "Core/JobSystem.hpp"
 
 class Cone
 {
+public:
+    struct ConeInfo
+    {
+        VkExtent2D  extent{1920, 1080};
+        bool        headless{false};
+        uint32_t    frameCount{0};      // 0 runs until the window is closed
+        std::string tracePath;          // Records CPU zones into this Chrome trace when set
+        bool        indirectDraw{true};
+        bool        frontToBack{true};  // Sorts draws by view distance inside each geometry block
+        bool        gpuCulling{true};   // Frustum culls indirect draws in a compute pass
+        bool        occlusionCulling{true};
+        bool        cpuCulling{true};   // Frustum culls on the CPU whatever the GPU does not
+        bool        parallelRecording{true};
+        bool        renderThread{true};     // Records frames on a render thread while the main thread runs ahead
+        uint32_t    pointLightCount{0};     // Extra small point lights scattered through the scene
+        bool        lightVolumes{false};    // Draws point lights as spheres instead of shading light clusters
+        bool        computeLighting{false}; // Shades in a tiled compute pass, ignored with light volumes
+        bool        compactGBuffer{false};  // Reconstructs position from depth and packs normals octahedrally
+        bool        compactHDR{false};      // B10G11R11 HDR target, rules out compute lighting
+        Renderer::DepthPrepassMode  depthPrepass{Renderer::DepthPrepassMode::Off};
+    };
 public:
     Cone() = default;
+    explicit Cone(const ConeInfo& coneInfo);
     ~Cone() = default;
 public:
     void Run();
+    // Shared with ConeBench so both measure the same scene
+    static std::unique_ptr<Scene> LoadMainScene(Context* context, AssetManager* assetManager, uint32_t pointLightCount = 0);
 private:
     void Init();
     void Draw();
+    bool ShouldClose() const;
     void CreateMainScene();
     void UpdateMainScene();
 private:
+    ConeInfo                        m_Info;
+    uint32_t                        m_FramesRendered{0};
+    std::unique_ptr<JobSystem>      m_JobSystem;
     std::unique_ptr<Window>         m_Window;
     std::unique_ptr<Context>        m_Context;
     std::unique_ptr<AssetManager>   m_AssetManager;
     std::unique_ptr<Renderer>       m_Renderer;
     std::unique_ptr<Scene>          m_MainScene;
+    // Without a render thread frames are drawn from m_Packet on the main thread
+    std::unique_ptr<RenderThread>   m_RenderThread;
+    RenderPacket                    m_Packet;
 };
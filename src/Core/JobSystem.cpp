@@ -0,0 +1,305 @@
+#include "Core/CnPch.hpp"
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <utility>
+
+struct JobSystem::Job
+{
+    Task        task;
+    Counter*    counter;
+};
+
+namespace
+{
+    // A handful of batches per thread lets threads that finish early steal from the slower ones
+    constexpr uint32_t BATCHES_PER_THREAD = 4;
+
+    // Deque owned by the current thread, threads the system did not start or was not created on own none
+    thread_local const JobSystem*   t_JobSystem     = nullptr;
+    thread_local uint32_t           t_ThreadIndex   = 0;
+}
+
+JobSystem::JobSystem(uint32_t workerCount)
+    :   m_QueuedJobs{0}, m_SleepingWorkers{0}, m_Stopping{false}
+{
+    // Deque 0 belongs to the creating thread
+    for(uint32_t i = 0; i < workerCount + 1; i++)
+    {
+        m_Deques.push_back(std::make_unique<WorkStealingDeque<Job>>());
+    }
+    t_JobSystem     = this;
+    t_ThreadIndex   = 0;
+
+    m_Workers.reserve(workerCount);
+    for(uint32_t i = 0; i < workerCount; i++)
+    {
+        m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+    }
+}
+
+uint32_t JobSystem::GetDefaultWorkerCount()
+{
+    uint32_t coreCount = std::thread::hardware_concurrency();
+    return std::max(coreCount, 2U) - 1;
+}
+
+void JobSystem::Run(Task task, Counter* counter, Counter* dependency)
+{
+    Job* job = AllocateJob(std::move(task), counter);
+    if(counter)
+    {
+        counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if(dependency)
+    {
+        // Finish drains the continuations under the same lock, so the job is either queued here or scheduled below
+        std::lock_guard<std::mutex> lock(dependency->m_Mutex);
+        if(!dependency->IsDone())
+        {
+            dependency->m_Continuations.push_back(job);
+            return;
+        }
+    }
+
+    Schedule(job);
+}
+
+void JobSystem::Wait(Counter& counter)
+{
+    // Threads without a deque cannot run jobs without breaking the thread index guarantee, they only yield
+    bool ownsDeque = t_JobSystem == this;
+    while(!counter.IsDone())
+    {
+        Job* job = ownsDeque ? FindJob(t_ThreadIndex) : nullptr;
+        if(job)
+        {
+            Execute(job, t_ThreadIndex);
+        } else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // Taking the lock also waits for the thread that finished the last job to let go of the counter
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_Mutex);
+        exception = std::exchange(counter.m_Exception, nullptr);
+    }
+
+    if(exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+void JobSystem::RunBatches(uint32_t count, uint32_t minBatchSize, const BatchTask& task)
+{
+    if(count == 0)
+    {
+        return;
+    }
+
+    uint32_t batchCount = std::clamp(count / std::max(minBatchSize, 1U), 1U, GetThreadCount() * BATCHES_PER_THREAD);
+    uint32_t batchSize  = (count + batchCount - 1) / batchCount;
+
+    Counter counter;
+    for(uint32_t first = 0; first < count; first += batchSize)
+    {
+        uint32_t end = std::min(count, first + batchSize);
+        Run([&task, first, end](uint32_t threadIndex)
+        {
+            for(uint32_t i = first; i < end; i++)
+            {
+                task(i, threadIndex);
+            }
+        }, &counter);
+    }
+
+    Wait(counter);
+}
+
+JobSystem::Job* JobSystem::AllocateJob(Task&& task, Counter* counter)
+{
+    Job* job = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_FreeJobsMutex);
+        if(!m_FreeJobs.empty())
+        {
+            job = m_FreeJobs.back();
+            m_FreeJobs.pop_back();
+        }
+    }
+
+    if(!job)
+    {
+        return new Job{std::move(task), counter};
+    }
+
+    job->task       = std::move(task);
+    job->counter    = counter;
+    return job;
+}
+
+void JobSystem::FreeJob(Job* job)
+{
+    // Captures are released now rather than whenever the job is reused
+    job->task = nullptr;
+
+    std::lock_guard<std::mutex> lock(m_FreeJobsMutex);
+    m_FreeJobs.push_back(job);
+}
+
+void JobSystem::Schedule(Job* job)
+{
+    // Counted before it is visible, so a thread taking it never sees the count drop below zero
+    m_QueuedJobs.fetch_add(1);
+
+    if(t_JobSystem != this || !m_Deques[t_ThreadIndex]->Push(job))
+    {
+        std::lock_guard<std::mutex> lock(m_InjectionMutex);
+        m_InjectionQueue.push_back(job);
+    }
+
+    // Pairs with the sleeping count being raised before a worker checks for queued jobs, one of the two sees the other
+    if(m_SleepingWorkers.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_WakeCondition.notify_one();
+    }
+}
+
+JobSystem::Job* JobSystem::FindJob(uint32_t threadIndex)
+{
+    Job* job = m_Deques[threadIndex]->Pop();
+
+    if(!job)
+    {
+        std::lock_guard<std::mutex> lock(m_InjectionMutex);
+        if(!m_InjectionQueue.empty())
+        {
+            job = m_InjectionQueue.front();
+            m_InjectionQueue.pop_front();
+        }
+    }
+
+    // Victims in order after this thread, so the thieves spread out instead of all emptying deque 0
+    uint32_t threadCount = GetThreadCount();
+    for(uint32_t i = 1; !job && i < threadCount; i++)
+    {
+        job = m_Deques[(threadIndex + i) % threadCount]->Steal();
+    }
+
+    if(job)
+    {
+        m_QueuedJobs.fetch_sub(1);
+    }
+    return job;
+}
+
+void JobSystem::Execute(Job* job, uint32_t threadIndex)
+{
+    try
+    {
+        job->task(threadIndex);
+    } catch(...)
+    {
+        if(job->counter)
+        {
+            std::lock_guard<std::mutex> lock(job->counter->m_Mutex);
+            if(!job->counter->m_Exception)
+            {
+                job->counter->m_Exception = std::current_exception();
+            }
+        } else
+        {
+            std::cout << "[Cone] A job without a counter threw, nothing waits on it to rethrow" << std::endl;
+        }
+    }
+
+    Counter* counter = job->counter;
+    FreeJob(job);
+
+    if(counter)
+    {
+        Finish(*counter);
+    }
+}
+
+void JobSystem::Finish(Counter& counter)
+{
+    // Under the lock, Wait locks the counter too before it returns and the counter can be destroyed
+    std::vector<Job*> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_Mutex);
+        if(counter.m_Pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+        continuations.swap(counter.m_Continuations);
+    }
+
+    for(Job* continuation : continuations)
+    {
+        Schedule(continuation);
+    }
+}
+
+void JobSystem::WorkerLoop(uint32_t threadIndex)
+{
+    t_JobSystem     = this;
+    t_ThreadIndex   = threadIndex;
+    Profiler::SetThreadName("Worker " + std::to_string(threadIndex));
+
+    while(!m_Stopping.load())
+    {
+        if(Job* job = FindJob(threadIndex))
+        {
+            Execute(job, threadIndex);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_SleepingWorkers.fetch_add(1);
+        m_WakeCondition.wait(lock, [this]() { return m_Stopping.load() || m_QueuedJobs.load() > 0; });
+        m_SleepingWorkers.fetch_sub(1);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Stopping = true;
+    }
+    m_WakeCondition.notify_all();
+
+    for(std::thread& worker : m_Workers)
+    {
+        worker.join();
+    }
+
+    // Jobs still queued never ran, nothing waits on them anymore
+    for(const std::unique_ptr<WorkStealingDeque<Job>>& deque : m_Deques)
+    {
+        while(Job* job = deque->Pop())
+        {
+            delete job;
+        }
+    }
+    for(Job* job : m_InjectionQueue)
+    {
+        delete job;
+    }
+    for(Job* job : m_FreeJobs)
+    {
+        delete job;
+    }
+
+    if(t_JobSystem == this)
+    {
+        t_JobSystem = nullptr;
+    }
+}
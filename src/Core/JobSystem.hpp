@@ -0,0 +1,90 @@
+#pragma once
+
+#include "WorkStealingDeque.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// Fixed set of worker threads, each owning a work-stealing deque. Jobs run from the deque of the thread that
+// scheduled them, idle workers steal from the others. The thread that created the system takes part as thread 0
+// whenever it waits, other threads only schedule and wait.
+class JobSystem
+{
+private:
+    struct Job;
+public:
+    using Task = std::function<void(uint32_t threadIndex)>;
+
+    // Counts the unfinished jobs scheduled with it. Jobs can depend on a counter and only start once it reached zero.
+    // Has to outlive every job it counts or that depends on it
+    class Counter
+    {
+    public:
+        Counter() = default;
+        ~Counter() = default;
+
+        Counter(const Counter& otherCounter) = delete;
+        Counter& operator=(const Counter& otherCounter) = delete;
+    public:
+        inline bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+    private:
+        friend class JobSystem;
+    private:
+        std::atomic<uint32_t>   m_Pending{0};
+        std::mutex              m_Mutex;
+        std::vector<Job*>       m_Continuations;
+        std::exception_ptr      m_Exception;
+    };
+public:
+    explicit JobSystem(uint32_t workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem& otherJobSystem) = delete;
+    JobSystem& operator=(const JobSystem& otherJobSystem) = delete;
+public:
+    // counter, if given, counts the job until it finished. The job waits for dependency to reach zero before it starts
+    void Run(Task task, Counter* counter = nullptr, Counter* dependency = nullptr);
+    // Runs other jobs on this thread until counter reaches zero, then rethrows the first exception one of its jobs threw
+    void Wait(Counter& counter);
+    // Calls task(i, threadIndex) for every i below count in batches of at least minBatchSize and waits for all of them.
+    // The thread index is below GetThreadCount() and stays the same for a whole batch
+    template<typename Function>
+    void ParallelFor(uint32_t count, uint32_t minBatchSize, const Function& task)
+    {
+        // Wrapped by reference, a std::function would put a capture list larger than two pointers on the heap
+        RunBatches(count, minBatchSize, std::cref(task));
+    }
+public:
+    // Workers plus the creating thread
+    inline uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Deques.size()); }
+    // One thread per core left after the main thread, at least one
+    static uint32_t GetDefaultWorkerCount();
+private:
+    using BatchTask = std::function<void(uint32_t index, uint32_t threadIndex)>;
+private:
+    void RunBatches(uint32_t count, uint32_t minBatchSize, const BatchTask& task);
+    Job* AllocateJob(Task&& task, Counter* counter);
+    void FreeJob(Job* job);
+    void Schedule(Job* job);
+    Job* FindJob(uint32_t threadIndex);
+    void Execute(Job* job, uint32_t threadIndex);
+    void Finish(Counter& counter);
+    void WorkerLoop(uint32_t threadIndex);
+private:
+    std::vector<std::unique_ptr<WorkStealingDeque<Job>>>        m_Deques;
+    std::vector<std::thread>                                    m_Workers;
+    // Jobs scheduled from threads without a deque, or from threads whose deque is full
+    std::mutex                                                  m_InjectionMutex;
+    std::deque<Job*>                                            m_InjectionQueue;
+    // Scheduled jobs no thread has taken yet, sleeping workers wake up when it rises
+    std::atomic<uint32_t>                                       m_QueuedJobs;
+    std::atomic<uint32_t>                                       m_SleepingWorkers;
+    std::mutex                                                  m_SleepMutex;
+    std::condition_variable                                     m_WakeCondition;
+    std::atomic<bool>                                           m_Stopping;
+    // Finished jobs are recycled, so scheduling does not allocate once enough jobs exist
+    std::mutex                                                  m_FreeJobsMutex;
+    std::vector<Job*>                                           m_FreeJobs;
+};
@@ -0,0 +1,67 @@
+#include "Core/CnPch.hpp"
+#include "LinearAllocator.hpp"
+
+#include <algorithm>
+
+LinearAllocator::LinearAllocator(size_t blockSize)
+    :   m_Offset{0}, m_UsedBytes{0}, m_Capacity{0}
+{
+    AddBlock(blockSize);
+}
+
+void LinearAllocator::Reset()
+{
+    // Everything the cycle needed fits into one block from now on
+    if(m_Blocks.size() > 1)
+    {
+        size_t capacity = m_Capacity;
+        m_Blocks.clear();
+        m_Capacity = 0;
+        AddBlock(capacity);
+    }
+
+    m_Offset    = 0;
+    m_UsedBytes = 0;
+}
+
+void* LinearAllocator::do_allocate(size_t bytes, size_t alignment)
+{
+    // Aligned by address, the block's memory itself is only aligned for std::max_align_t
+    auto alignedOffset = [this, alignment]()
+    {
+        uintptr_t base = reinterpret_cast<uintptr_t>(m_Blocks.back().memory.get());
+        return ((base + m_Offset + alignment - 1) & ~(alignment - 1)) - base;
+    };
+
+    size_t offset = alignedOffset();
+    if(offset + bytes > m_Blocks.back().size)
+    {
+        // Worst case padding included so the allocation always fits the new block
+        AddBlock(std::max(m_Blocks.back().size * 2, bytes + alignment));
+        offset = alignedOffset();
+    }
+
+    m_UsedBytes += offset - m_Offset + bytes;
+    m_Offset     = offset + bytes;
+    return m_Blocks.back().memory.get() + offset;
+}
+
+void LinearAllocator::do_deallocate(void*, size_t, size_t)
+{
+}
+
+bool LinearAllocator::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void LinearAllocator::AddBlock(size_t minSize)
+{
+    Block block{};
+    block.memory    = std::make_unique<std::byte[]>(minSize);
+    block.size      = minSize;
+    m_Blocks.push_back(std::move(block));
+
+    m_Offset    = 0;
+    m_Capacity += minSize;
+}
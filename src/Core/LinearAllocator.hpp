@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory_resource>
+
+// Bump allocator for data that dies all at once, handed to std::pmr containers as their memory resource.
+// Deallocation is a no-op, Reset releases everything. When a cycle outgrew the first block, Reset replaces the
+// blocks with one that holds the whole cycle, so a steady workload allocates from the system only while warming up.
+// Not thread safe, every thread gets its own.
+class LinearAllocator : public std::pmr::memory_resource
+{
+public:
+    explicit LinearAllocator(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~LinearAllocator() override = default;
+
+    LinearAllocator(const LinearAllocator& otherAllocator) = delete;
+    LinearAllocator& operator=(const LinearAllocator& otherAllocator) = delete;
+public:
+    void Reset();
+public:
+    inline size_t GetUsedBytes() const { return m_UsedBytes; }
+    inline size_t GetCapacity() const { return m_Capacity; }
+    inline static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+private:
+    void AddBlock(size_t minSize);
+private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]>    memory;
+        size_t                          size;
+    };
+private:
+    std::vector<Block>  m_Blocks;
+    size_t              m_Offset;
+    size_t              m_UsedBytes;
+    size_t              m_Capacity;
+};
@@ -0,0 +1,254 @@
+#include "CnPch.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+
+namespace
+{
+    constexpr uint32_t CHUNK_EVENTS = 4096;
+    constexpr uint32_t MAX_CHUNKS   = 256;
+
+    struct Event
+    {
+        const char* name;
+        uint64_t    startNs;
+        uint64_t    endNs;
+        uint32_t    depth;
+        char        detail[Profiler::Zone::MAX_DETAIL_LENGTH + 1];
+    };
+
+    struct Chunk
+    {
+        std::array<Event, CHUNK_EVENTS> events;
+    };
+
+    // Written by its owning thread only, the count is published with release so End() reads a consistent prefix
+    struct ThreadBuffer
+    {
+        uint32_t                                        threadId{0};
+        std::string                                     threadName;
+        std::array<std::atomic<Chunk*>, MAX_CHUNKS>     chunks{};
+        std::atomic<uint32_t>                           count{0};
+        std::atomic<uint64_t>                           dropped{0};
+        uint32_t                                        depth{0};
+
+        ~ThreadBuffer()
+        {
+            for(std::atomic<Chunk*>& chunk : chunks)
+            {
+                delete chunk.load();
+            }
+        }
+    };
+
+    struct ProfilerState
+    {
+        std::atomic<bool>                           recording{false};
+        std::chrono::steady_clock::time_point       epoch{std::chrono::steady_clock::now()};
+        std::string                                 tracePath;
+        // Only taken when a thread records for the first time, when naming threads and in Begin/End
+        std::mutex                                  registryMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>>  buffers;
+    };
+
+    ProfilerState& GetState()
+    {
+        static ProfilerState state;
+        return state;
+    }
+
+    ThreadBuffer& GetThreadBuffer()
+    {
+        thread_local ThreadBuffer* threadBuffer = []()
+        {
+            ProfilerState& state = GetState();
+            std::lock_guard<std::mutex> lock(state.registryMutex);
+
+            state.buffers.push_back(std::make_unique<ThreadBuffer>());
+            state.buffers.back()->threadId = static_cast<uint32_t>(state.buffers.size());
+            return state.buffers.back().get();
+        }();
+
+        return *threadBuffer;
+    }
+
+    uint64_t GetTimeNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - GetState().epoch).count());
+    }
+
+    void Record(ThreadBuffer& buffer, const Event& event)
+    {
+        uint32_t index = buffer.count.load(std::memory_order_relaxed);
+        if(index >= CHUNK_EVENTS * MAX_CHUNKS)
+        {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::atomic<Chunk*>& chunkSlot = buffer.chunks[index / CHUNK_EVENTS];
+        Chunk* chunk = chunkSlot.load(std::memory_order_acquire);
+        if(chunk == nullptr)
+        {
+            chunk = new Chunk();
+            chunkSlot.store(chunk, std::memory_order_release);
+        }
+
+        chunk->events[index % CHUNK_EVENTS] = event;
+        buffer.count.store(index + 1, std::memory_order_release);
+    }
+
+    void WriteEscaped(std::ostream& stream, std::string_view text)
+    {
+        for(char character : text)
+        {
+            switch(character)
+            {
+                case '"':   stream << "\\\""; break;
+                case '\\':  stream << "\\\\"; break;
+                case '\n':  stream << "\\n"; break;
+                case '\t':  stream << "\\t"; break;
+                default:
+                    if(static_cast<unsigned char>(character) >= 0x20)
+                    {
+                        stream << character;
+                    }
+            }
+        }
+    }
+}
+
+namespace Profiler
+{
+    void Begin(std::string_view tracePath)
+    {
+        ProfilerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.registryMutex);
+
+        for(std::unique_ptr<ThreadBuffer>& buffer : state.buffers)
+        {
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+
+        state.tracePath = std::string(tracePath);
+        state.epoch     = std::chrono::steady_clock::now();
+        state.recording.store(true, std::memory_order_release);
+    }
+
+    void End()
+    {
+        ProfilerState& state = GetState();
+        if(!state.recording.exchange(false))
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(state.registryMutex);
+
+        std::ofstream traceFile(state.tracePath);
+        if(!traceFile.is_open())
+        {
+            throw std::runtime_error("Error: Failed to open trace file " + state.tracePath);
+        }
+
+        size_t eventCount = 0;
+        uint64_t droppedCount = 0;
+        bool first = true;
+
+        // Microseconds with nanosecond fractions, the default precision would round long captures
+        traceFile << std::fixed << std::setprecision(3);
+        traceFile << "{\"traceEvents\":[\n";
+        for(const std::unique_ptr<ThreadBuffer>& buffer : state.buffers)
+        {
+            if(!buffer->threadName.empty())
+            {
+                traceFile << (first ? "" : ",\n") << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->threadId << R"(,"args":{"name":")";
+                WriteEscaped(traceFile, buffer->threadName);
+                traceFile << "\"}}";
+                first = false;
+            }
+
+            uint32_t count = buffer->count.load(std::memory_order_acquire);
+            for(uint32_t i = 0; i < count; i++)
+            {
+                const Event& event = buffer->chunks[i / CHUNK_EVENTS].load(std::memory_order_acquire)->events[i % CHUNK_EVENTS];
+
+                traceFile << (first ? "" : ",\n") << R"({"name":")";
+                WriteEscaped(traceFile, event.name);
+                traceFile << R"(","cat":"cone","ph":"X","pid":1,"tid":)" << buffer->threadId
+                          << ",\"ts\":" << static_cast<double>(event.startNs) / 1000.0
+                          << ",\"dur\":" << static_cast<double>(event.endNs - event.startNs) / 1000.0
+                          << ",\"args\":{\"depth\":" << event.depth;
+                if(event.detail[0] != '\0')
+                {
+                    traceFile << ",\"detail\":\"";
+                    WriteEscaped(traceFile, event.detail);
+                    traceFile << "\"";
+                }
+                traceFile << "}}";
+                first = false;
+            }
+
+            eventCount += count;
+            droppedCount += buffer->dropped.load(std::memory_order_relaxed);
+        }
+        traceFile << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        std::cout << "[Cone] Trace written to " << state.tracePath << " (" << eventCount << " zones, " << droppedCount << " dropped)" << std::endl;
+    }
+
+    bool IsRecording()
+    {
+        return GetState().recording.load(std::memory_order_relaxed);
+    }
+
+    void SetThreadName(std::string_view name)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+
+        std::lock_guard<std::mutex> lock(GetState().registryMutex);
+        buffer.threadName = std::string(name);
+    }
+
+    Zone::Zone(const char* name, std::string_view detail)
+        :   m_Name{name}, m_StartNs{0}, m_Active{IsRecording()}, m_Detail{}
+    {
+        if(!m_Active)
+        {
+            return;
+        }
+
+        size_t detailLength = std::min(detail.size(), MAX_DETAIL_LENGTH);
+        std::memcpy(m_Detail, detail.data(), detailLength);
+        m_Detail[detailLength] = '\0';
+
+        GetThreadBuffer().depth++;
+        m_StartNs = GetTimeNs();
+    }
+
+    Zone::~Zone()
+    {
+        if(!m_Active)
+        {
+            return;
+        }
+
+        uint64_t endNs = GetTimeNs();
+        ThreadBuffer& buffer = GetThreadBuffer();
+
+        Event event{};
+        event.name      = m_Name;
+        event.startNs   = m_StartNs;
+        event.endNs     = endNs;
+        event.depth     = --buffer.depth;
+        std::memcpy(event.detail, m_Detail, sizeof(m_Detail));
+
+        Record(buffer, event);
+    }
+}
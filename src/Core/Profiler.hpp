@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Scoped CPU zones exported as a Chrome trace (chrome://tracing, Perfetto).
+// Compiled out entirely unless CN_ENABLE_PROFILER is defined, and a single relaxed load per zone while not recording.
+namespace Profiler
+{
+    // Starts recording, events from an earlier recording are dropped. Call while no zones are open on other threads.
+    void Begin(std::string_view tracePath);
+    // Stops recording and writes everything recorded so far to the trace file
+    void End();
+    bool IsRecording();
+    void SetThreadName(std::string_view name);
+
+    class Zone
+    {
+    public:
+        explicit Zone(const char* name, std::string_view detail = {});
+        ~Zone();
+
+        Zone(const Zone& otherZone) = delete;
+        Zone& operator=(const Zone& otherZone) = delete;
+    public:
+        inline static constexpr size_t MAX_DETAIL_LENGTH = 63;
+    private:
+        const char* m_Name;
+        uint64_t    m_StartNs;
+        bool        m_Active;
+        char        m_Detail[MAX_DETAIL_LENGTH + 1];
+    };
+}
+
+#ifdef CN_ENABLE_PROFILER
+    #define CN_PROFILE_CONCAT_INNER(a, b) a##b
+    #define CN_PROFILE_CONCAT(a, b) CN_PROFILE_CONCAT_INNER(a, b)
+    #define CN_PROFILE_ZONE(name) Profiler::Zone CN_PROFILE_CONCAT(cnProfileZone, __LINE__){name}
+    #define CN_PROFILE_ZONE_DETAIL(name, detail) Profiler::Zone CN_PROFILE_CONCAT(cnProfileZone, __LINE__){name, detail}
+    #define CN_PROFILE_FUNCTION() CN_PROFILE_ZONE(__func__)
+#else
+    #define CN_PROFILE_ZONE(name)
+    #define CN_PROFILE_ZONE_DETAIL(name, detail)
+    #define CN_PROFILE_FUNCTION()
+#endif
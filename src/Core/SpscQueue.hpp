@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+
+// Bounded lock-free queue between exactly one producer and one consumer thread.
+// The blocking Push and Pop sleep on the opposite index with C++20 atomic waits instead of spinning.
+template<typename T, uint32_t Capacity>
+class SpscQueue
+{
+public:
+    SpscQueue() = default;
+    ~SpscQueue() = default;
+
+    SpscQueue(const SpscQueue& otherQueue) = delete;
+    SpscQueue& operator=(const SpscQueue& otherQueue) = delete;
+public:
+    // Producer only, false when full
+    bool TryPush(const T& item)
+    {
+        uint32_t tail = m_Tail.load(std::memory_order_relaxed);
+        if(tail - m_Head.load(std::memory_order_acquire) == Capacity)
+        {
+            return false;
+        }
+
+        m_Items[tail % Capacity] = item;
+        m_Tail.store(tail + 1, std::memory_order_release);
+        m_Tail.notify_one();
+        return true;
+    }
+
+    // Consumer only, false when empty
+    bool TryPop(T& item)
+    {
+        uint32_t head = m_Head.load(std::memory_order_relaxed);
+        if(head == m_Tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        item = m_Items[head % Capacity];
+        m_Head.store(head + 1, std::memory_order_release);
+        m_Head.notify_one();
+        return true;
+    }
+
+    void Push(const T& item)
+    {
+        while(!TryPush(item))
+        {
+            // Full means the consumer is exactly Capacity behind, sleep until it moves
+            m_Head.wait(m_Tail.load(std::memory_order_relaxed) - Capacity, std::memory_order_acquire);
+        }
+    }
+
+    T Pop()
+    {
+        T item{};
+        while(!TryPop(item))
+        {
+            // Empty means the producer is where the consumer is, sleep until it moves
+            m_Tail.wait(m_Head.load(std::memory_order_relaxed), std::memory_order_acquire);
+        }
+        return item;
+    }
+private:
+    // Indices wrap around, which stays consistent with the modulo only for power of two capacities
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "Queue capacity has to be a power of two");
+private:
+    alignas(64) std::atomic<uint32_t>   m_Head{0};
+    alignas(64) std::atomic<uint32_t>   m_Tail{0};
+    std::array<T, Capacity>             m_Items{};
+};
@@ -1,9 +1,75 @@
 #include "Core/CnPch.hpp"
 #include "Core/Cone.hpp"
 
-int main()
+int main(int argc, char** argv)
 {
-    Cone cone{};
+    Cone::ConeInfo coneInfo{};
+
+    // --headless renders offscreen without a window, --frames N stops after N frames, --trace <file> writes a CPU trace,
+    // --direct-draw issues one draw call per submesh instead of indirect draws, --no-culling draws every submesh,
+    // --no-occlusion keeps frustum culling but skips the depth pyramid test, --no-cpu-culling draws every submesh the GPU does not cull,
+    // --no-depth-sort orders draws by material instead of front to back, --no-parallel-recording records direct draws on one thread,
+    // --no-render-thread records every frame on the main thread, --point-lights N adds N small point lights to the scene,
+    // --light-volumes draws point lights as spheres instead of shading light clusters, --compute-lighting shades in tiled compute,
+    // --compact-gbuffer reconstructs position from depth and packs normals octahedrally, --compact-hdr uses a B10G11R11 HDR target,
+    // --depth-prepass <off|on|auto> lays down depth before the G-buffer pass, auto keeps whichever measures faster
+    for(int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+        if(arg == "--headless")
+        {
+            coneInfo.headless = true;
+        } else if(arg == "--frames" && i + 1 < argc)
+        {
+            coneInfo.frameCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if(arg == "--trace" && i + 1 < argc)
+        {
+            coneInfo.tracePath = argv[++i];
+        } else if(arg == "--direct-draw")
+        {
+            coneInfo.indirectDraw = false;
+        } else if(arg == "--no-depth-sort")
+        {
+            coneInfo.frontToBack = false;
+        } else if(arg == "--no-culling")
+        {
+            coneInfo.gpuCulling = false;
+            coneInfo.cpuCulling = false;
+        } else if(arg == "--no-occlusion")
+        {
+            coneInfo.occlusionCulling = false;
+        } else if(arg == "--no-cpu-culling")
+        {
+            coneInfo.cpuCulling = false;
+        } else if(arg == "--no-parallel-recording")
+        {
+            coneInfo.parallelRecording = false;
+        } else if(arg == "--no-render-thread")
+        {
+            coneInfo.renderThread = false;
+        } else if(arg == "--point-lights" && i + 1 < argc)
+        {
+            coneInfo.pointLightCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if(arg == "--light-volumes")
+        {
+            coneInfo.lightVolumes = true;
+        } else if(arg == "--compute-lighting")
+        {
+            coneInfo.computeLighting = true;
+        } else if(arg == "--compact-gbuffer")
+        {
+            coneInfo.compactGBuffer = true;
+        } else if(arg == "--compact-hdr")
+        {
+            coneInfo.compactHDR = true;
+        } else if(arg == "--depth-prepass" && i + 1 < argc)
+        {
+            std::string_view mode = argv[++i];
+            coneInfo.depthPrepass = mode == "on" ? Renderer::DepthPrepassMode::On : mode == "auto" ? Renderer::DepthPrepassMode::Auto : Renderer::DepthPrepassMode::Off;
+        }
+    }
+
+    Cone cone{coneInfo};
     cone.Run();
 
     return 0;
@@ -0,0 +1,33 @@
+#include "Core/CnPch.hpp"
+#include "BarrierBatch.hpp"
+
+void BarrierBatch::AddImageBarrier(const VkImageMemoryBarrier2& barrier)
+{
+    m_ImageBarriers.push_back(barrier);
+}
+
+void BarrierBatch::AddBufferBarrier(const VkBufferMemoryBarrier2& barrier)
+{
+    m_BufferBarriers.push_back(barrier);
+}
+
+void BarrierBatch::Flush(VkCommandBuffer commandBuffer)
+{
+    if(m_ImageBarriers.empty() && m_BufferBarriers.empty())
+    {
+        return;
+    }
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount  = static_cast<uint32_t>(m_ImageBarriers.size());
+    dependencyInfo.pImageMemoryBarriers     = m_ImageBarriers.data();
+    dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(m_BufferBarriers.size());
+    dependencyInfo.pBufferMemoryBarriers    = m_BufferBarriers.data();
+
+    vkCmdPipelineBarrier2KHR(commandBuffer, &dependencyInfo);
+
+    // Keeps the capacity so steady state frames do not reallocate
+    m_ImageBarriers.clear();
+    m_BufferBarriers.clear();
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+class BarrierBatch
+{
+public:
+    BarrierBatch() = default;
+    ~BarrierBatch() = default;
+
+    BarrierBatch(const BarrierBatch& otherBatch) = delete;
+    BarrierBatch& operator=(const BarrierBatch& otherBatch) = delete;
+public:
+    void AddImageBarrier(const VkImageMemoryBarrier2& barrier);
+    void AddBufferBarrier(const VkBufferMemoryBarrier2& barrier);
+    void Flush(VkCommandBuffer commandBuffer);
+public:
+    inline size_t GetPendingCount() const { return m_ImageBarriers.size() + m_BufferBarriers.size(); }
+private:
+    std::vector<VkImageMemoryBarrier2>  m_ImageBarriers;
+    std::vector<VkBufferMemoryBarrier2> m_BufferBarriers;
+};
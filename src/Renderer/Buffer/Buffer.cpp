@@ -19,9 +19,16 @@ Buffer::Buffer(Context* context, const BufferInfo& bufferInfo)
     vmaCreateBuffer(m_Context->GetAllocator(), &bufferCreateInfo, &allocInfo, &m_Buffer, &m_Allocation, &m_AllocInfo);
 }
 
-void Buffer::Map(const void* memory, VkDeviceSize size) const
+void Buffer::Map(const void* memory, VkDeviceSize size, VkDeviceSize offset) const
 {
-    memcpy(m_AllocInfo.pMappedData, memory, static_cast<size_t>(size));
+    memcpy(static_cast<char*>(m_AllocInfo.pMappedData) + offset, memory, static_cast<size_t>(size));
+}
+
+void Buffer::Read(void* memory, VkDeviceSize size, VkDeviceSize offset) const
+{
+    // Non coherent memory has to be invalidated before the host sees device writes
+    VK_CHECK(vmaInvalidateAllocation(m_Context->GetAllocator(), m_Allocation, offset, size))
+    memcpy(memory, static_cast<const char*>(m_AllocInfo.pMappedData) + offset, static_cast<size_t>(size));
 }
 
 void Buffer::Transfer(Buffer* dstBuffer)
@@ -26,7 +26,9 @@ public:
     inline VkDeviceSize GetSize() const { return m_AllocInfo.size; }
     inline VkDeviceSize GetOffset() const { return m_AllocInfo.offset; }
 public:
-    void Map(const void* memory, VkDeviceSize size) const;
+    void Map(const void* memory, VkDeviceSize size, VkDeviceSize offset = 0) const;
+    // Copies out of a mapped buffer written by the GPU, the writes have to be complete
+    void Read(void* memory, VkDeviceSize size, VkDeviceSize offset = 0) const;
     void Transfer(Buffer* dstBuffer);
 private:
     Context*            m_Context;
@@ -0,0 +1,123 @@
+#include "Core/CnPch.hpp"
+#include "GeometryArena.hpp"
+
+#include "Renderer/Context.hpp"
+#include "Renderer/CommandRecorder.hpp"
+
+#include <algorithm>
+
+GeometryArena::GeometryArena(Context* context)
+    :   m_Context{context}
+{
+}
+
+GeometryArena::Range GeometryArena::Upload(std::span<const Vertex> vertices, std::span<const uint32_t> indices)
+{
+    uint32_t vertexCount    = static_cast<uint32_t>(vertices.size());
+    uint32_t indexCount     = static_cast<uint32_t>(indices.size());
+    uint32_t blockIndex     = FindBlock(vertexCount, indexCount);
+    Block& block            = m_Blocks[blockIndex];
+
+    Range range{};
+    range.block         = blockIndex;
+    range.vertexOffset  = static_cast<int32_t>(block.vertexCount);
+    range.firstIndex    = block.indexCount;
+    range.vertexCount   = vertexCount;
+    range.indexCount    = indexCount;
+
+    VkDeviceSize vertexSize = vertices.size_bytes();
+    VkDeviceSize indexSize  = indices.size_bytes();
+    if(vertexSize + indexSize == 0)
+    {
+        return range;
+    }
+
+    Buffer::BufferInfo stagingBufferInfo{};
+    stagingBufferInfo.size              = vertexSize + indexSize;
+    stagingBufferInfo.usageFlags        = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    stagingBufferInfo.vmaMemoryUsage    = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    stagingBufferInfo.vmaAllocFlags     = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    Buffer stagingBuffer{m_Context, stagingBufferInfo};
+    if(vertexSize != 0)
+    {
+        stagingBuffer.Map(vertices.data(), vertexSize);
+    }
+    if(indexSize != 0)
+    {
+        stagingBuffer.Map(indices.data(), indexSize, vertexSize);
+    }
+
+    std::array<VkBufferCopy, 2> copyRegions{};
+    copyRegions[0].srcOffset    = 0;
+    copyRegions[0].dstOffset    = static_cast<VkDeviceSize>(block.vertexCount) * sizeof(Vertex);
+    copyRegions[0].size         = vertexSize;
+    copyRegions[1].srcOffset    = vertexSize;
+    copyRegions[1].dstOffset    = static_cast<VkDeviceSize>(block.indexCount) * sizeof(uint32_t);
+    copyRegions[1].size         = indexSize;
+
+    VkCommandBuffer cmdBuffer = m_Context->BeginSingleTimeCommands(Context::CommandType::TRANSFER);
+    if(vertexSize != 0)
+    {
+        vkCmdCopyBuffer(cmdBuffer, stagingBuffer.GetBuffer(), block.vertexBuffer->GetBuffer(), 1, &copyRegions[0]);
+    }
+    if(indexSize != 0)
+    {
+        vkCmdCopyBuffer(cmdBuffer, stagingBuffer.GetBuffer(), block.indexBuffer->GetBuffer(), 1, &copyRegions[1]);
+    }
+    m_Context->EndSingleTimeCommands(Context::CommandType::TRANSFER, cmdBuffer);
+
+    block.vertexCount   += vertexCount;
+    block.indexCount    += indexCount;
+
+    return range;
+}
+
+uint32_t GeometryArena::FindBlock(uint32_t vertexCount, uint32_t indexCount)
+{
+    for(size_t i = 0; i < m_Blocks.size(); i++)
+    {
+        const Block& block = m_Blocks[i];
+        if(block.vertexCount + vertexCount <= block.vertexCapacity && block.indexCount + indexCount <= block.indexCapacity)
+        {
+            return static_cast<uint32_t>(i);
+        }
+    }
+
+    // A mesh bigger than a default block gets a block of its own size
+    CreateBlock(std::max(vertexCount, BLOCK_VERTEX_CAPACITY), std::max(indexCount, BLOCK_INDEX_CAPACITY));
+    return static_cast<uint32_t>(m_Blocks.size() - 1);
+}
+
+void GeometryArena::CreateBlock(uint32_t vertexCapacity, uint32_t indexCapacity)
+{
+    Buffer::BufferInfo vertexBufferInfo{};
+    vertexBufferInfo.size           = static_cast<VkDeviceSize>(vertexCapacity) * sizeof(Vertex);
+    vertexBufferInfo.usageFlags     = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    vertexBufferInfo.vmaMemoryUsage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    vertexBufferInfo.vmaAllocFlags  = 0;
+
+    Buffer::BufferInfo indexBufferInfo{};
+    indexBufferInfo.size            = static_cast<VkDeviceSize>(indexCapacity) * sizeof(uint32_t);
+    indexBufferInfo.usageFlags      = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    indexBufferInfo.vmaMemoryUsage  = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    indexBufferInfo.vmaAllocFlags   = 0;
+
+    Block block{};
+    block.vertexBuffer      = std::make_unique<Buffer>(m_Context, vertexBufferInfo);
+    block.indexBuffer       = std::make_unique<Buffer>(m_Context, indexBufferInfo);
+    block.vertexCapacity    = vertexCapacity;
+    block.indexCapacity     = indexCapacity;
+    block.vertexCount       = 0;
+    block.indexCount        = 0;
+
+    m_Blocks.push_back(std::move(block));
+
+    std::cout << "[Cone] Geometry arena block " << m_Blocks.size() - 1 << ": " << vertexCapacity << " vertices, " << indexCapacity << " indices" << std::endl;
+}
+
+void GeometryArena::Bind(CommandRecorder& recorder, uint32_t block) const
+{
+    recorder.BindVertexBuffer(m_Blocks[block].vertexBuffer->GetBuffer(), 0);
+    recorder.BindIndexBuffer(m_Blocks[block].indexBuffer->GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
+}
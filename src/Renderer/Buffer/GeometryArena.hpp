@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Buffer.hpp"
+#include "Vertex.hpp"
+
+class Context;
+class CommandRecorder;
+
+// Suballocates the geometry of all meshes out of a few large device local vertex and index buffers.
+// Meshes are never unloaded, so allocation only bumps the end of the current block.
+class GeometryArena
+{
+public:
+    struct Range
+    {
+        uint32_t    block;
+        int32_t     vertexOffset;
+        uint32_t    firstIndex;
+        uint32_t    vertexCount;
+        uint32_t    indexCount;
+    };
+public:
+    explicit GeometryArena(Context* context);
+    ~GeometryArena() = default;
+
+    GeometryArena(const GeometryArena& otherArena) = delete;
+    GeometryArena& operator=(const GeometryArena& otherArena) = delete;
+public:
+    // Copies through a single staging buffer, indices stay relative to the first vertex of the range
+    Range Upload(std::span<const Vertex> vertices, std::span<const uint32_t> indices);
+    void Bind(CommandRecorder& recorder, uint32_t block) const;
+public:
+    inline uint32_t GetBlockCount() const { return static_cast<uint32_t>(m_Blocks.size()); }
+    inline VkBuffer GetVertexBuffer(uint32_t block) const { return m_Blocks[block].vertexBuffer->GetBuffer(); }
+    inline VkBuffer GetIndexBuffer(uint32_t block) const { return m_Blocks[block].indexBuffer->GetBuffer(); }
+    inline static constexpr uint32_t BLOCK_VERTEX_CAPACITY = 1u << 20;
+    inline static constexpr uint32_t BLOCK_INDEX_CAPACITY = 1u << 22;
+private:
+    struct Block
+    {
+        std::unique_ptr<Buffer> vertexBuffer;
+        std::unique_ptr<Buffer> indexBuffer;
+        uint32_t                vertexCapacity;
+        uint32_t                indexCapacity;
+        uint32_t                vertexCount;
+        uint32_t                indexCount;
+    };
+private:
+    uint32_t FindBlock(uint32_t vertexCount, uint32_t indexCount);
+    void CreateBlock(uint32_t vertexCapacity, uint32_t indexCapacity);
+private:
+    Context*            m_Context;
+    std::vector<Block>  m_Blocks;
+};
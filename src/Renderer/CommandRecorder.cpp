@@ -0,0 +1,188 @@
+#include "Core/CnPch.hpp"
+#include "CommandRecorder.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+uint32_t CommandRecorder::Stats::GetIssued() const
+{
+    return pipelines.issued + descriptorSets.issued + vertexBuffers.issued + indexBuffers.issued + pushConstants.issued + viewports.issued + scissors.issued;
+}
+
+uint32_t CommandRecorder::Stats::GetElided() const
+{
+    return pipelines.elided + descriptorSets.elided + vertexBuffers.elided + indexBuffers.elided + pushConstants.elided + viewports.elided + scissors.elided;
+}
+
+CommandRecorder::Stats& CommandRecorder::Stats::operator+=(const Stats& otherStats)
+{
+    auto add = [](CallCounter& counter, const CallCounter& otherCounter)
+    {
+        counter.issued += otherCounter.issued;
+        counter.elided += otherCounter.elided;
+    };
+
+    add(pipelines,      otherStats.pipelines);
+    add(descriptorSets, otherStats.descriptorSets);
+    add(vertexBuffers,  otherStats.vertexBuffers);
+    add(indexBuffers,   otherStats.indexBuffers);
+    add(pushConstants,  otherStats.pushConstants);
+    add(viewports,      otherStats.viewports);
+    add(scissors,       otherStats.scissors);
+    return *this;
+}
+
+void CommandRecorder::Begin(VkCommandBuffer commandBuffer)
+{
+    m_CommandBuffer = commandBuffer;
+    Invalidate();
+    m_Stats         = {};
+}
+
+void CommandRecorder::Invalidate()
+{
+    m_GraphicsState         = {};
+    m_ComputeState          = {};
+    m_VertexBuffer          = VK_NULL_HANDLE;
+    m_VertexOffset          = 0;
+    m_IndexBuffer           = VK_NULL_HANDLE;
+    m_IndexOffset           = 0;
+    m_IndexType             = VK_INDEX_TYPE_UINT32;
+    m_PushConstantLayout    = VK_NULL_HANDLE;
+    m_PushConstantStages    = {};
+    m_Viewport.reset();
+    m_Scissor.reset();
+}
+
+CommandRecorder::BindPointState& CommandRecorder::GetBindPointState(VkPipelineBindPoint bindPoint)
+{
+    return bindPoint == VK_PIPELINE_BIND_POINT_COMPUTE ? m_ComputeState : m_GraphicsState;
+}
+
+void CommandRecorder::BindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline)
+{
+    BindPointState& state = GetBindPointState(bindPoint);
+    if(state.pipeline == pipeline)
+    {
+        m_Stats.pipelines.elided++;
+        return;
+    }
+
+    vkCmdBindPipeline(m_CommandBuffer, bindPoint, pipeline);
+    state.pipeline = pipeline;
+    m_Stats.pipelines.issued++;
+}
+
+void CommandRecorder::BindDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t index, VkDescriptorSet descriptorSet)
+{
+    BindPointState& state = GetBindPointState(bindPoint);
+    if(index >= MAX_DESCRIPTOR_SETS)
+    {
+        throw std::runtime_error("Error: Descriptor set index is beyond what the command recorder tracks.");
+    }
+
+    BoundSet& boundSet = state.sets[index];
+    if(boundSet.layout == layout && boundSet.descriptorSet == descriptorSet)
+    {
+        m_Stats.descriptorSets.elided++;
+        return;
+    }
+
+    vkCmdBindDescriptorSets(m_CommandBuffer, bindPoint, layout, index, 1U, &descriptorSet, 0U, nullptr);
+    m_Stats.descriptorSets.issued++;
+
+    // Sets bound through another layout may have been disturbed, rather than checking compatibility they are forgotten
+    for(BoundSet& otherSet : state.sets)
+    {
+        if(otherSet.layout != layout)
+        {
+            otherSet = {};
+        }
+    }
+    boundSet = { layout, descriptorSet };
+}
+
+void CommandRecorder::BindVertexBuffer(VkBuffer buffer, VkDeviceSize offset)
+{
+    if(m_VertexBuffer == buffer && m_VertexOffset == offset)
+    {
+        m_Stats.vertexBuffers.elided++;
+        return;
+    }
+
+    vkCmdBindVertexBuffers(m_CommandBuffer, 0, 1, &buffer, &offset);
+    m_VertexBuffer = buffer;
+    m_VertexOffset = offset;
+    m_Stats.vertexBuffers.issued++;
+}
+
+void CommandRecorder::BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType)
+{
+    if(m_IndexBuffer == buffer && m_IndexOffset == offset && m_IndexType == indexType)
+    {
+        m_Stats.indexBuffers.elided++;
+        return;
+    }
+
+    vkCmdBindIndexBuffer(m_CommandBuffer, buffer, offset, indexType);
+    m_IndexBuffer   = buffer;
+    m_IndexOffset   = offset;
+    m_IndexType     = indexType;
+    m_Stats.indexBuffers.issued++;
+}
+
+void CommandRecorder::PushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* data)
+{
+    if(offset + size > MAX_PUSH_CONSTANT_SIZE)
+    {
+        throw std::runtime_error("Error: Push constant range is beyond what the command recorder tracks.");
+    }
+
+    if(m_PushConstantLayout != layout)
+    {
+        m_PushConstantLayout = layout;
+        m_PushConstantStages = {};
+    }
+
+    bool unchanged = std::memcmp(m_PushConstantData.data() + offset, data, size) == 0;
+    for(uint32_t i = offset; i < offset + size && unchanged; i++)
+    {
+        unchanged = m_PushConstantStages[i] == stageFlags;
+    }
+    if(unchanged)
+    {
+        m_Stats.pushConstants.elided++;
+        return;
+    }
+
+    vkCmdPushConstants(m_CommandBuffer, layout, stageFlags, offset, size, data);
+    std::memcpy(m_PushConstantData.data() + offset, data, size);
+    std::fill(m_PushConstantStages.begin() + offset, m_PushConstantStages.begin() + offset + size, stageFlags);
+    m_Stats.pushConstants.issued++;
+}
+
+void CommandRecorder::SetViewport(const VkViewport& viewport)
+{
+    if(m_Viewport && std::memcmp(&*m_Viewport, &viewport, sizeof(VkViewport)) == 0)
+    {
+        m_Stats.viewports.elided++;
+        return;
+    }
+
+    vkCmdSetViewport(m_CommandBuffer, 0U, 1U, &viewport);
+    m_Viewport = viewport;
+    m_Stats.viewports.issued++;
+}
+
+void CommandRecorder::SetScissor(const VkRect2D& scissor)
+{
+    if(m_Scissor && std::memcmp(&*m_Scissor, &scissor, sizeof(VkRect2D)) == 0)
+    {
+        m_Stats.scissors.elided++;
+        return;
+    }
+
+    vkCmdSetScissor(m_CommandBuffer, 0U, 1U, &scissor);
+    m_Scissor = scissor;
+    m_Stats.scissors.issued++;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+// Shadows the state bound on one command buffer and drops binds and pushes that would change nothing.
+// Pipelines record through it, anything that binds state on the command buffer directly has to Begin again.
+class CommandRecorder
+{
+public:
+    struct CallCounter
+    {
+        uint32_t    issued{0};
+        uint32_t    elided{0};
+    };
+    struct Stats
+    {
+        CallCounter pipelines;
+        CallCounter descriptorSets;
+        CallCounter vertexBuffers;
+        CallCounter indexBuffers;
+        CallCounter pushConstants;
+        CallCounter viewports;
+        CallCounter scissors;
+
+        uint32_t GetIssued() const;
+        uint32_t GetElided() const;
+        Stats& operator+=(const Stats& otherStats);
+    };
+public:
+    CommandRecorder() = default;
+    ~CommandRecorder() = default;
+
+    CommandRecorder(const CommandRecorder& otherRecorder) = delete;
+    CommandRecorder& operator=(const CommandRecorder& otherRecorder) = delete;
+public:
+    // Starts over with nothing bound, right after vkBeginCommandBuffer. Also resets the counters
+    void Begin(VkCommandBuffer commandBuffer);
+    // Forgets the bound state but keeps the counters, after vkCmdExecuteCommands left it undefined
+    void Invalidate();
+    // Folds in the counters of recorders that recorded secondary command buffers for this one
+    inline void AddStats(const Stats& stats) { m_Stats += stats; }
+    void BindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline);
+    void BindDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t index, VkDescriptorSet descriptorSet);
+    void BindVertexBuffer(VkBuffer buffer, VkDeviceSize offset);
+    void BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType);
+    void PushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* data);
+    void SetViewport(const VkViewport& viewport);
+    void SetScissor(const VkRect2D& scissor);
+public:
+    inline VkCommandBuffer GetCommandBuffer() const { return m_CommandBuffer; }
+    // Calls since the last Begin
+    inline const Stats& GetStats() const { return m_Stats; }
+    // Vulkan guarantees at least 128 bytes of push constants, which is all any layout here uses
+    inline static constexpr uint32_t MAX_PUSH_CONSTANT_SIZE = 128;
+    inline static constexpr uint32_t MAX_DESCRIPTOR_SETS    = 8;
+private:
+    struct BoundSet
+    {
+        VkPipelineLayout    layout{VK_NULL_HANDLE};
+        VkDescriptorSet     descriptorSet{VK_NULL_HANDLE};
+    };
+    // Graphics and compute binds do not affect each other
+    struct BindPointState
+    {
+        VkPipeline                                  pipeline{VK_NULL_HANDLE};
+        std::array<BoundSet, MAX_DESCRIPTOR_SETS>   sets{};
+    };
+private:
+    BindPointState& GetBindPointState(VkPipelineBindPoint bindPoint);
+private:
+    VkCommandBuffer                                     m_CommandBuffer{VK_NULL_HANDLE};
+    BindPointState                                      m_GraphicsState{};
+    BindPointState                                      m_ComputeState{};
+    VkBuffer                                            m_VertexBuffer{VK_NULL_HANDLE};
+    VkDeviceSize                                        m_VertexOffset{0};
+    VkBuffer                                            m_IndexBuffer{VK_NULL_HANDLE};
+    VkDeviceSize                                        m_IndexOffset{0};
+    VkIndexType                                         m_IndexType{VK_INDEX_TYPE_UINT32};
+    // Push constant contents are only comparable under the layout they were pushed with
+    VkPipelineLayout                                    m_PushConstantLayout{VK_NULL_HANDLE};
+    std::array<uint8_t, MAX_PUSH_CONSTANT_SIZE>         m_PushConstantData{};
+    // Stage flags each byte was pushed with, 0 for bytes never pushed
+    std::array<VkShaderStageFlags, MAX_PUSH_CONSTANT_SIZE> m_PushConstantStages{};
+    std::optional<VkViewport>                           m_Viewport;
+    std::optional<VkRect2D>                             m_Scissor;
+    Stats                                               m_Stats{};
+};
@@ -0,0 +1,92 @@
+#include "Core/CnPch.hpp"
+#include "ComputePipeline.hpp"
+
+#include "GpuProfiler.hpp"
+#include "CommandRecorder.hpp"
+
+ComputePipeline::ComputePipeline(Context* context, const PipelineInfo& info)
+    :   m_Context{context}, m_Pipeline{}, m_PipelineLayout{}, m_CurrentCommandBuffer{}, m_Name{info.name}, m_Profiler{info.profiler}, m_Recorder{info.recorder}
+{
+    CN_PROFILE_ZONE_DETAIL("CreateComputePipeline", info.name);
+
+    auto computeCode = Utilities::ReadShaderCode(info.computePath);
+    VkShaderModule computeModule = Utilities::CreateShaderModule(m_Context->GetLogicalDevice(), computeCode);
+
+    VkPipelineShaderStageCreateInfo computeShaderStageInfo{};
+    computeShaderStageInfo.sType    = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    computeShaderStageInfo.stage    = VK_SHADER_STAGE_COMPUTE_BIT;
+    computeShaderStageInfo.module   = computeModule;
+    computeShaderStageInfo.pName    = "main";
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType                    = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount           = info.layouts.size();
+    pipelineLayoutInfo.pSetLayouts              = info.layouts.data();
+    pipelineLayoutInfo.pushConstantRangeCount   = info.pushConstants.size();
+    pipelineLayoutInfo.pPushConstantRanges      = info.pushConstants.data();
+
+    VK_CHECK(vkCreatePipelineLayout(m_Context->GetLogicalDevice(), &pipelineLayoutInfo, nullptr, &m_PipelineLayout))
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage  = computeShaderStageInfo;
+    pipelineInfo.layout = m_PipelineLayout;
+
+    VK_CHECK(vkCreateComputePipelines(m_Context->GetLogicalDevice(), VK_NULL_HANDLE, 1U, &pipelineInfo, nullptr, &m_Pipeline))
+
+    vkDestroyShaderModule(m_Context->GetLogicalDevice(), computeModule, nullptr);
+}
+
+void ComputePipeline::Begin(VkCommandBuffer commandBuffer, std::string_view scopeName)
+{
+    if(m_Recorder->GetCommandBuffer() != commandBuffer)
+    {
+        throw std::runtime_error("Error: Pipeline " + m_Name + " records into a command buffer its recorder was not begun on.");
+    }
+
+    m_CurrentCommandBuffer = commandBuffer;
+
+    if(m_Profiler)
+    {
+        m_Profiler->BeginScope(m_CurrentCommandBuffer, scopeName.empty() ? m_Name : scopeName);
+    }
+
+    m_Recorder->BindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, m_Pipeline);
+}
+
+void ComputePipeline::End()
+{
+    if(m_Profiler)
+    {
+        m_Profiler->EndScope(m_CurrentCommandBuffer);
+    }
+    m_CurrentCommandBuffer = VK_NULL_HANDLE;
+}
+
+void ComputePipeline::Dispatch(const uint32_t groupCountX, const uint32_t groupCountY, const uint32_t groupCountZ)
+{
+    vkCmdDispatch(m_CurrentCommandBuffer, groupCountX, groupCountY, groupCountZ);
+}
+
+void ComputePipeline::BindDescriptorSet(VkDescriptorSet descriptorSet, const uint32_t index)
+{
+    m_Recorder->BindDescriptorSet(VK_PIPELINE_BIND_POINT_COMPUTE, m_PipelineLayout, index, descriptorSet);
+}
+
+void ComputePipeline::PushConstant(const uint32_t offset, const uint32_t size, const void* data)
+{
+    m_Recorder->PushConstants(m_PipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, offset, size, data);
+}
+
+ComputePipeline::~ComputePipeline()
+{
+    if(m_PipelineLayout)
+    {
+        vkDestroyPipelineLayout(m_Context->GetLogicalDevice(), m_PipelineLayout, nullptr);
+    }
+
+    if(m_Pipeline)
+    {
+        vkDestroyPipeline(m_Context->GetLogicalDevice(), m_Pipeline, nullptr);
+    }
+}
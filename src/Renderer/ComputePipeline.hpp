@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Context.hpp"
+
+class GpuProfiler;
+class CommandRecorder;
+
+class ComputePipeline
+{
+public:
+    struct PipelineInfo
+    {
+        std::string_view                    computePath;
+        std::vector<VkDescriptorSetLayout>  layouts;
+        std::vector<VkPushConstantRange>    pushConstants;
+
+        // Optional, Begin/End are timed as a scope with this name
+        std::string_view    name;
+        GpuProfiler*        profiler;
+        // Required, like for graphics pipelines
+        CommandRecorder*    recorder;
+    };
+public:
+    ComputePipeline(Context* context, const PipelineInfo& info);
+    ~ComputePipeline();
+
+    ComputePipeline(const ComputePipeline& otherPipeline) = delete;
+    ComputePipeline& operator=(const ComputePipeline& otherPipeline) = delete;
+public:
+    // scopeName overrides the profiler scope of pipelines recorded by more than one pass
+    void Begin(VkCommandBuffer commandBuffer, std::string_view scopeName = {});
+    void End();
+    void Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
+    void BindDescriptorSet(VkDescriptorSet descriptorSet, uint32_t index);
+    void PushConstant(uint32_t offset, uint32_t size, const void* data);
+private:
+    Context*            m_Context;
+    VkPipeline          m_Pipeline;
+    VkPipelineLayout    m_PipelineLayout;
+    VkCommandBuffer     m_CurrentCommandBuffer;
+    std::string         m_Name;
+    GpuProfiler*        m_Profiler;
+    CommandRecorder*    m_Recorder;
+};
@@ -4,11 +4,12 @@
 
 #include "Window.hpp"
 
-Context::Context(const Window* window)
+Context::Context(const Window* window, VkExtent2D extent)
         : m_Instance{}, m_Allocator{}, m_DebugMessenger{}, m_PhysicalDevice{},
           m_LogicalDevice{}, m_GraphicsQueue{}, m_PresentQueue{}, m_TransferQueue{}, m_GraphicsQueueFamily{},
           m_TransferQueueFamily{}, m_GraphicsCommandPool{}, m_TransferCommandPool{}, m_Surface{},
-          m_SurfaceExtent{window->GetExtent2D()}, m_EnableValidation{true}, m_HasSeperateTransferQueue{false}
+          m_SurfaceExtent{extent}, m_EnableValidation{true}, m_HasSeperateTransferQueue{false},
+          m_Headless{window == nullptr}
 {
 #ifdef NDEBUG
     m_EnableValidation = false;
@@ -37,17 +38,25 @@ void Context::InitVulkan(const Window* window)
      * Instance
      */
     vkb::InstanceBuilder instanceBuilder;
-    auto inst_ret = instanceBuilder.set_app_name("Cone Engine")
+    instanceBuilder.set_app_name("Cone Engine")
             .request_validation_layers(m_EnableValidation)
             .require_api_version(1, 2, 0)
-            .enable_extension("VK_KHR_surface")
             .use_default_debug_messenger();
 
+    // Headless instances skip the surface extensions so they can be created without a display
+    if(m_Headless)
+    {
+        instanceBuilder.set_headless(true);
+    } else
+    {
+        instanceBuilder.enable_extension("VK_KHR_surface");
+    }
+
 #ifdef __APPLE__
     instanceBuilder.enable_extension("VK_KHR_get_physical_device_properties2");
 #endif
 
-    vkb::Instance vkbInstance = inst_ret.build().value();
+    vkb::Instance vkbInstance = instanceBuilder.build().value();
     m_Instance = vkbInstance.instance;
     m_DebugMessenger = vkbInstance.debug_messenger;
 
@@ -56,7 +65,10 @@ void Context::InitVulkan(const Window* window)
     /*
      * Surface
      */
-    VK_CHECK(glfwCreateWindowSurface(m_Instance, window->GetGLFWWindow(), nullptr, &m_Surface))
+    if(!m_Headless)
+    {
+        VK_CHECK(glfwCreateWindowSurface(m_Instance, window->GetGLFWWindow(), nullptr, &m_Surface))
+    }
 
     /*
      * Device
@@ -65,25 +77,50 @@ void Context::InitVulkan(const Window* window)
     dynamicRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
     dynamicRendering.dynamicRendering = VK_TRUE;
 
+    VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2{};
+    synchronization2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+    synchronization2.synchronization2 = VK_TRUE;
+
+    // Bindless material table, see MaterialTable. Checked when picking the device and chained by vk-bootstrap
+    VkPhysicalDeviceVulkan12Features features12{};
+    features12.sType                                        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    features12.descriptorIndexing                           = VK_TRUE;
+    features12.shaderSampledImageArrayNonUniformIndexing    = VK_TRUE;
+    features12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    features12.descriptorBindingUpdateUnusedWhilePending    = VK_TRUE;
+    features12.descriptorBindingPartiallyBound              = VK_TRUE;
+    features12.runtimeDescriptorArray                       = VK_TRUE;
+
     VkPhysicalDeviceFeatures features{};
-    features.samplerAnisotropy = VK_TRUE;
+    features.samplerAnisotropy          = VK_TRUE;
+    features.multiDrawIndirect          = VK_TRUE;
+    features.drawIndirectFirstInstance  = VK_TRUE;
 
     vkb::PhysicalDeviceSelector pDeviceSelector{vkbInstance};
-
-    vkb::PhysicalDevice vkbPhysicalDevice = pDeviceSelector.set_minimum_version(1, 1)
-            .set_surface(m_Surface)
-            .add_desired_extension("VK_KHR_dynamic_rendering")
+    // Every pass renders without render pass objects, so dynamic rendering is not optional
+    pDeviceSelector.set_minimum_version(1, 2)
+            .add_required_extension("VK_KHR_dynamic_rendering")
             .add_desired_extension("VK_KHR_depth_stencil_resolve")
             .add_desired_extension("VK_KHR_create_renderpass2")
+            .add_required_extension("VK_KHR_draw_indirect_count")
+            .add_required_extension("VK_KHR_synchronization2")
             .set_required_features(features)
-            .select()
-            .value();
+            .set_required_features_12(features12);
+
+    // Without a surface the device is picked on features alone, software drivers included
+    if(!m_Headless)
+    {
+        pDeviceSelector.set_surface(m_Surface);
+    }
+
+    vkb::PhysicalDevice vkbPhysicalDevice = pDeviceSelector.select().value();
 
     m_HasSeperateTransferQueue = vkbPhysicalDevice.has_separate_transfer_queue();
 
     vkb::DeviceBuilder deviceBuilder{vkbPhysicalDevice};
     vkb::Device vkbLogicalDevice = deviceBuilder
             .add_pNext(&dynamicRendering)
+            .add_pNext(&synchronization2)
             .build()
             .value();
 
@@ -93,7 +130,10 @@ void Context::InitVulkan(const Window* window)
     volkLoadDevice(m_LogicalDevice);
 
     m_GraphicsQueue = vkbLogicalDevice.get_queue(vkb::QueueType::graphics).value();
-    m_PresentQueue = vkbLogicalDevice.get_queue(vkb::QueueType::present).value();
+    if(!m_Headless)
+    {
+        m_PresentQueue = vkbLogicalDevice.get_queue(vkb::QueueType::present).value();
+    }
     m_GraphicsQueueFamily = vkbLogicalDevice.get_queue_index(vkb::QueueType::graphics).value();
 
     if(m_HasSeperateTransferQueue)
@@ -11,7 +11,7 @@ public:
         TRANSFER
     };
 public:
-    explicit Context(const Window* window);
+    Context(const Window* window, VkExtent2D extent);
     ~Context();
 
     Context(const Context& otherContext) = delete;
@@ -25,7 +25,9 @@ public:
     inline VkQueue GetGraphicsQueue() const { return m_GraphicsQueue; }
     inline VkQueue GetPresentQueue() const { return m_PresentQueue; }
     inline VkQueue GetTransferQueue() const { return m_TransferQueue; }
+    inline uint32_t GetGraphicsQueueFamily() const { return m_GraphicsQueueFamily; }
     inline VmaAllocator GetAllocator() const { return m_Allocator; }
+    inline bool IsHeadless() const { return m_Headless; }
 public:
     VkCommandBuffer BeginSingleTimeCommands(CommandType type);
     void EndSingleTimeCommands(CommandType type, VkCommandBuffer commandBuffer);
@@ -51,4 +53,5 @@ private:
 private:
     bool                        m_EnableValidation;
     bool                        m_HasSeperateTransferQueue;
+    bool                        m_Headless;
 };
@@ -0,0 +1,59 @@
+#include "Core/CnPch.hpp"
+#include "DepthPrepassSelector.hpp"
+
+void DepthPrepassSelector::AddSample(bool usedPrepass, double milliseconds)
+{
+    if(m_Phase == Phase::Settled)
+    {
+        if(++m_PhaseFrames >= SETTLE_FRAMES)
+        {
+            StartPhase(Phase::MeasureWithout);
+        }
+        return;
+    }
+
+    // Frames still in flight when the phase changed were recorded in the other mode
+    if(usedPrepass != (m_Phase == Phase::MeasureWith))
+    {
+        return;
+    }
+
+    m_PhaseMs += milliseconds;
+    if(++m_PhaseFrames < SAMPLE_FRAMES)
+    {
+        return;
+    }
+
+    double averageMs = m_PhaseMs / static_cast<double>(m_PhaseFrames);
+    if(m_Phase == Phase::MeasureWithout)
+    {
+        m_WithoutMs = averageMs;
+        StartPhase(Phase::MeasureWith);
+    } else
+    {
+        m_Prepass = averageMs < m_WithoutMs * (1.0 - MIN_GAIN);
+        StartPhase(Phase::Settled);
+    }
+}
+
+bool DepthPrepassSelector::UsePrepass() const
+{
+    switch(m_Phase)
+    {
+        case Phase::MeasureWithout:
+            return false;
+        case Phase::MeasureWith:
+            return true;
+        case Phase::Settled:
+            return m_Prepass;
+    }
+
+    return false;
+}
+
+void DepthPrepassSelector::StartPhase(Phase phase)
+{
+    m_Phase         = phase;
+    m_PhaseMs       = 0.0;
+    m_PhaseFrames   = 0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// Decides from measured GPU time whether the depth pre-pass pays for itself. The pre-pass only helps when the
+// G-buffer pass shades pixels more than once, so overdraw is judged by its cost: the G-buffer pass alone against
+// the pre-pass plus the G-buffer pass with EQUAL. Both modes are measured for SAMPLE_FRAMES frames each, the cheaper
+// one is kept for SETTLE_FRAMES frames, then both are measured again as the view and the scene change.
+class DepthPrepassSelector
+{
+public:
+    DepthPrepassSelector() = default;
+    ~DepthPrepassSelector() = default;
+
+    DepthPrepassSelector(const DepthPrepassSelector& otherSelector) = delete;
+    DepthPrepassSelector& operator=(const DepthPrepassSelector& otherSelector) = delete;
+public:
+    // GPU time of the pre-pass and the early geometry pass of a finished frame, usedPrepass is the mode it was recorded with
+    void AddSample(bool usedPrepass, double milliseconds);
+    // Mode the next frame is recorded with
+    bool UsePrepass() const;
+public:
+    inline static constexpr uint32_t SAMPLE_FRAMES = 32;
+    inline static constexpr uint32_t SETTLE_FRAMES = 1024;
+    // The pre-pass has to be this much cheaper, otherwise noise flips the mode with every measurement
+    inline static constexpr double MIN_GAIN = 0.05;
+private:
+    enum class Phase
+    {
+        MeasureWithout,
+        MeasureWith,
+        Settled
+    };
+private:
+    void StartPhase(Phase phase);
+private:
+    Phase       m_Phase{Phase::MeasureWithout};
+    double      m_WithoutMs{0.0};
+    double      m_PhaseMs{0.0};
+    uint32_t    m_PhaseFrames{0};
+    bool        m_Prepass{false};
+};
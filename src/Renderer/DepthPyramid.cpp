@@ -0,0 +1,181 @@
+#include "Core/CnPch.hpp"
+#include "DepthPyramid.hpp"
+
+#include "Context.hpp"
+
+DepthPyramid::DepthPyramid(Context* context, const std::vector<const Image*>& depthImages, GpuProfiler* profiler, CommandRecorder* recorder)
+    :   m_Context{context}, m_DepthImages{depthImages}, m_Sampler{}
+{
+    CreatePyramid();
+    CreateSampler();
+    CreateDescriptorSets();
+    CreatePipeline(profiler, recorder);
+}
+
+void DepthPyramid::CreatePyramid()
+{
+    // Left undefined here, the first build transitions it
+    Image::ImageInfo pyramidInfo{};
+    pyramidInfo.format          = VK_FORMAT_R32_SFLOAT;
+    pyramidInfo.desiredLayout   = VK_IMAGE_LAYOUT_UNDEFINED;
+    pyramidInfo.dimension       = m_DepthImages.front()->GetDimension();
+    pyramidInfo.usageFlags      = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    pyramidInfo.aspectFlags     = VK_IMAGE_ASPECT_COLOR_BIT;
+    pyramidInfo.genMipmaps      = VK_TRUE;
+
+    m_Pyramid = std::make_unique<Image>(m_Context, pyramidInfo);
+
+    m_MipViews.resize(m_Pyramid->GetMipLevels());
+    for(uint32_t i = 0; i < m_Pyramid->GetMipLevels(); i++)
+    {
+        VkImageViewCreateInfo viewCreateInfo{};
+        viewCreateInfo.sType                            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewCreateInfo.image                            = m_Pyramid->GetImage();
+        viewCreateInfo.viewType                         = VK_IMAGE_VIEW_TYPE_2D;
+        viewCreateInfo.format                           = VK_FORMAT_R32_SFLOAT;
+        viewCreateInfo.subresourceRange.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewCreateInfo.subresourceRange.baseMipLevel    = i;
+        viewCreateInfo.subresourceRange.levelCount      = 1;
+        viewCreateInfo.subresourceRange.baseArrayLayer  = 0;
+        viewCreateInfo.subresourceRange.layerCount      = 1;
+
+        VK_CHECK(vkCreateImageView(m_Context->GetLogicalDevice(), &viewCreateInfo, nullptr, &m_MipViews[i]))
+    }
+}
+
+void DepthPyramid::CreateSampler()
+{
+    // Only read with texelFetch, nearest keeps the footprints exact
+    VkSamplerCreateInfo samplerCreateInfo{};
+    samplerCreateInfo.sType             = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerCreateInfo.magFilter         = VK_FILTER_NEAREST;
+    samplerCreateInfo.minFilter         = VK_FILTER_NEAREST;
+    samplerCreateInfo.mipmapMode        = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerCreateInfo.addressModeU      = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeV      = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeW      = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.minLod            = 0.0f;
+    samplerCreateInfo.maxLod            = static_cast<float>(m_Pyramid->GetMipLevels());
+
+    VK_CHECK(vkCreateSampler(m_Context->GetLogicalDevice(), &samplerCreateInfo, nullptr, &m_Sampler))
+}
+
+void DepthPyramid::CreateDescriptorSets()
+{
+    for(const Image* depthImage : m_DepthImages)
+    {
+        m_DepthDescriptorSets.push_back(CreateLevelDescriptorSet(depthImage->GetImageView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0));
+    }
+    for(uint32_t i = 1; i < m_Pyramid->GetMipLevels(); i++)
+    {
+        m_LevelDescriptorSets.push_back(CreateLevelDescriptorSet(m_MipViews[i - 1], VK_IMAGE_LAYOUT_GENERAL, i));
+    }
+
+    // Whole pyramid for the culling pass
+    VkDescriptorImageInfo pyramidInfo{};
+    pyramidInfo.sampler     = m_Sampler;
+    pyramidInfo.imageView   = m_Pyramid->GetImageView();
+    pyramidInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+    DescriptorSet::BindingInfo pyramidBinding{};
+    pyramidBinding.type         = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    pyramidBinding.binding      = 0;
+    pyramidBinding.stageFlags   = VK_SHADER_STAGE_COMPUTE_BIT;
+    pyramidBinding.imageInfo    = &pyramidInfo;
+
+    std::vector<DescriptorSet::BindingInfo> bindings = { pyramidBinding };
+    m_PyramidDescriptorSet = std::make_unique<DescriptorSet>(m_Context, bindings);
+}
+
+std::unique_ptr<DescriptorSet> DepthPyramid::CreateLevelDescriptorSet(VkImageView sourceView, VkImageLayout sourceLayout, uint32_t level) const
+{
+    VkDescriptorImageInfo sourceInfo{};
+    sourceInfo.sampler      = m_Sampler;
+    sourceInfo.imageView    = sourceView;
+    sourceInfo.imageLayout  = sourceLayout;
+
+    DescriptorSet::BindingInfo sourceBinding{};
+    sourceBinding.type          = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    sourceBinding.binding       = 0;
+    sourceBinding.stageFlags    = VK_SHADER_STAGE_COMPUTE_BIT;
+    sourceBinding.imageInfo     = &sourceInfo;
+
+    VkDescriptorImageInfo destinationInfo{};
+    destinationInfo.imageView   = m_MipViews[level];
+    destinationInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+    DescriptorSet::BindingInfo destinationBinding{};
+    destinationBinding.type         = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    destinationBinding.binding      = 1;
+    destinationBinding.stageFlags   = VK_SHADER_STAGE_COMPUTE_BIT;
+    destinationBinding.imageInfo    = &destinationInfo;
+
+    std::vector<DescriptorSet::BindingInfo> bindings = { sourceBinding, destinationBinding };
+    return std::make_unique<DescriptorSet>(m_Context, bindings);
+}
+
+void DepthPyramid::CreatePipeline(GpuProfiler* profiler, CommandRecorder* recorder)
+{
+    VkPushConstantRange paramsPushConstant{};
+    paramsPushConstant.stageFlags   = VK_SHADER_STAGE_COMPUTE_BIT;
+    paramsPushConstant.offset       = 0U;
+    paramsPushConstant.size         = sizeof(PyramidParams);
+
+    ComputePipeline::PipelineInfo pipeInfo{};
+    pipeInfo.computePath    = "/Shaders/DepthPyramidComp.spv";
+    pipeInfo.layouts        = { m_DepthDescriptorSets[0]->GetDescriptorSetLayout() };
+    pipeInfo.pushConstants  = { paramsPushConstant };
+
+    pipeInfo.name           = "DepthPyramid";
+    pipeInfo.profiler       = profiler;
+    pipeInfo.recorder       = recorder;
+
+    m_Pipeline = std::make_unique<ComputePipeline>(m_Context, pipeInfo);
+}
+
+void DepthPyramid::Build(VkCommandBuffer commandBuffer, size_t frameIndex)
+{
+    m_Pipeline->Begin(commandBuffer);
+
+    VkExtent2D sourceExtent = m_DepthImages[frameIndex]->GetDimension();
+    for(uint32_t i = 0; i < m_Pyramid->GetMipLevels(); i++)
+    {
+        VkExtent2D destinationExtent = { std::max(1U, m_Pyramid->GetDimension().width >> i), std::max(1U, m_Pyramid->GetDimension().height >> i) };
+
+        // Waits on last frame's culling reads of this level, and on the level above being written
+        m_Pyramid->ChangeLayout(m_BarrierBatch, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, i, 1);
+        m_BarrierBatch.Flush(commandBuffer);
+
+        PyramidParams params{};
+        params.sourceWidth          = static_cast<int32_t>(sourceExtent.width);
+        params.sourceHeight         = static_cast<int32_t>(sourceExtent.height);
+        params.destinationWidth     = static_cast<int32_t>(destinationExtent.width);
+        params.destinationHeight    = static_cast<int32_t>(destinationExtent.height);
+        params.copy                 = i == 0 ? 1U : 0U;
+
+        const DescriptorSet& levelSet = i == 0 ? *m_DepthDescriptorSets[frameIndex] : *m_LevelDescriptorSets[i - 1];
+        m_Pipeline->BindDescriptorSet(levelSet.GetDescriptorSet(), 0U);
+        m_Pipeline->PushConstant(0U, sizeof(PyramidParams), &params);
+        // 8x8 invocations per group, see DepthPyramid.comp
+        m_Pipeline->Dispatch((destinationExtent.width + 7) / 8, (destinationExtent.height + 7) / 8);
+
+        m_Pyramid->ChangeLayout(m_BarrierBatch, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, i, 1);
+        sourceExtent = destinationExtent;
+    }
+    m_BarrierBatch.Flush(commandBuffer);
+
+    m_Pipeline->End();
+}
+
+DepthPyramid::~DepthPyramid()
+{
+    for(VkImageView view : m_MipViews)
+    {
+        vkDestroyImageView(m_Context->GetLogicalDevice(), view, nullptr);
+    }
+
+    if(m_Sampler)
+    {
+        vkDestroySampler(m_Context->GetLogicalDevice(), m_Sampler, nullptr);
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Image.hpp"
+#include "BarrierBatch.hpp"
+#include "ComputePipeline.hpp"
+#include "DescriptorSet.hpp"
+
+class Context;
+class GpuProfiler;
+
+// Hierarchical-Z pyramid of a depth attachment, every texel holds the farthest depth of its footprint.
+// Level 0 matches the depth attachment, each further level halves it, odd edges fold into the last texel.
+class DepthPyramid
+{
+public:
+    // Matches PyramidParams in DepthPyramid.comp
+    struct PyramidParams
+    {
+        int32_t     sourceWidth;
+        int32_t     sourceHeight;
+        int32_t     destinationWidth;
+        int32_t     destinationHeight;
+        uint32_t    copy;
+    };
+public:
+    // One depth attachment per frame in flight, all of the same size
+    DepthPyramid(Context* context, const std::vector<const Image*>& depthImages, GpuProfiler* profiler, CommandRecorder* recorder);
+    ~DepthPyramid();
+
+    DepthPyramid(const DepthPyramid& otherPyramid) = delete;
+    DepthPyramid& operator=(const DepthPyramid& otherPyramid) = delete;
+public:
+    // The frame's depth attachment has to be in SHADER_READ_ONLY_OPTIMAL, the pyramid is left readable by compute shaders
+    void Build(VkCommandBuffer commandBuffer, size_t frameIndex);
+public:
+    inline VkDescriptorSet GetDescriptorSet() const { return m_PyramidDescriptorSet->GetDescriptorSet(); }
+    inline VkDescriptorSetLayout GetDescriptorSetLayout() const { return m_PyramidDescriptorSet->GetDescriptorSetLayout(); }
+    inline VkExtent2D GetExtent() const { return m_Pyramid->GetDimension(); }
+    inline uint32_t GetMipLevels() const { return m_Pyramid->GetMipLevels(); }
+private:
+    void CreatePyramid();
+    void CreateSampler();
+    void CreateDescriptorSets();
+    std::unique_ptr<DescriptorSet> CreateLevelDescriptorSet(VkImageView sourceView, VkImageLayout sourceLayout, uint32_t level) const;
+    void CreatePipeline(GpuProfiler* profiler, CommandRecorder* recorder);
+private:
+    Context*                                        m_Context;
+    std::vector<const Image*>                       m_DepthImages;
+    std::unique_ptr<Image>                          m_Pyramid;
+    std::vector<VkImageView>                        m_MipViews;
+    VkSampler                                       m_Sampler;
+    // Level 0 copies the frame's depth attachment, one set per frame in flight
+    std::vector<std::unique_ptr<DescriptorSet>>     m_DepthDescriptorSets;
+    // One per further level, reading the level above and writing the level, level 1 first
+    std::vector<std::unique_ptr<DescriptorSet>>     m_LevelDescriptorSets;
+    std::unique_ptr<DescriptorSet>                  m_PyramidDescriptorSet;
+    std::unique_ptr<ComputePipeline>                m_Pipeline;
+    BarrierBatch                                    m_BarrierBatch;
+};
@@ -0,0 +1,92 @@
+#include "Core/CnPch.hpp"
+#include "FrameCommandPools.hpp"
+
+#include "Context.hpp"
+
+FrameCommandPools::FrameCommandPools(Context* context, uint32_t threadCount)
+    :   m_Context{context}
+{
+    for(FrameResources& frame : m_Frames)
+    {
+        frame.primaryPool = CreatePool();
+
+        VkCommandBufferAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.commandPool        = frame.primaryPool;
+        allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocateInfo.commandBufferCount = 1U;
+
+        VK_CHECK(vkAllocateCommandBuffers(m_Context->GetLogicalDevice(), &allocateInfo, &frame.primaryBuffer))
+
+        frame.secondaryPools.resize(threadCount);
+        for(SecondaryPool& secondaryPool : frame.secondaryPools)
+        {
+            secondaryPool.pool = CreatePool();
+        }
+    }
+}
+
+VkCommandPool FrameCommandPools::CreatePool()
+{
+    // Transient, everything allocated from it is re-recorded every time the frame slot comes around
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags              = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex   = m_Context->GetGraphicsQueueFamily();
+
+    VkCommandPool pool{};
+    VK_CHECK(vkCreateCommandPool(m_Context->GetLogicalDevice(), &poolInfo, nullptr, &pool))
+
+    return pool;
+}
+
+void FrameCommandPools::Reset(size_t frameIndex)
+{
+    CN_PROFILE_FUNCTION();
+
+    FrameResources& frame = m_Frames[frameIndex];
+    VK_CHECK(vkResetCommandPool(m_Context->GetLogicalDevice(), frame.primaryPool, 0U))
+
+    for(SecondaryPool& secondaryPool : frame.secondaryPools)
+    {
+        if(secondaryPool.usedCount == 0)
+        {
+            continue;
+        }
+
+        VK_CHECK(vkResetCommandPool(m_Context->GetLogicalDevice(), secondaryPool.pool, 0U))
+        secondaryPool.usedCount = 0;
+    }
+}
+
+VkCommandBuffer FrameCommandPools::AcquireSecondary(size_t frameIndex, uint32_t thread)
+{
+    SecondaryPool& secondaryPool = m_Frames[frameIndex].secondaryPools[thread];
+    if(secondaryPool.usedCount == secondaryPool.buffers.size())
+    {
+        VkCommandBufferAllocateInfo allocateInfo{};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.commandPool        = secondaryPool.pool;
+        allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocateInfo.commandBufferCount = 1U;
+
+        VkCommandBuffer buffer{};
+        VK_CHECK(vkAllocateCommandBuffers(m_Context->GetLogicalDevice(), &allocateInfo, &buffer))
+        secondaryPool.buffers.push_back(buffer);
+    }
+
+    return secondaryPool.buffers[secondaryPool.usedCount++];
+}
+
+FrameCommandPools::~FrameCommandPools()
+{
+    // Destroying a pool frees everything allocated from it
+    for(FrameResources& frame : m_Frames)
+    {
+        vkDestroyCommandPool(m_Context->GetLogicalDevice(), frame.primaryPool, nullptr);
+        for(SecondaryPool& secondaryPool : frame.secondaryPools)
+        {
+            vkDestroyCommandPool(m_Context->GetLogicalDevice(), secondaryPool.pool, nullptr);
+        }
+    }
+}
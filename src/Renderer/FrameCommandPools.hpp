@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Swapchain.hpp"
+
+class Context;
+
+// Command pools owned per frame slot: one for the slot's primary command buffer and one per recording thread
+// for secondary buffers. Once the slot's fence signalled its pools are reset as a whole, no buffer is reset on its own.
+class FrameCommandPools
+{
+public:
+    FrameCommandPools(Context* context, uint32_t threadCount);
+    ~FrameCommandPools();
+
+    FrameCommandPools(const FrameCommandPools& otherPools) = delete;
+    FrameCommandPools& operator=(const FrameCommandPools& otherPools) = delete;
+public:
+    void Reset(size_t frameIndex);
+    // Only the thread with this index may call this, buffers are recycled after Reset and allocated when a thread needs more
+    VkCommandBuffer AcquireSecondary(size_t frameIndex, uint32_t thread);
+public:
+    inline VkCommandBuffer GetPrimary(size_t frameIndex) const { return m_Frames[frameIndex].primaryBuffer; }
+    inline uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Frames[0].secondaryPools.size()); }
+private:
+    struct SecondaryPool
+    {
+        VkCommandPool                   pool{VK_NULL_HANDLE};
+        std::vector<VkCommandBuffer>    buffers;
+        uint32_t                        usedCount{0};
+    };
+    struct FrameResources
+    {
+        VkCommandPool                   primaryPool{VK_NULL_HANDLE};
+        VkCommandBuffer                 primaryBuffer{VK_NULL_HANDLE};
+        std::vector<SecondaryPool>      secondaryPools;
+    };
+private:
+    VkCommandPool CreatePool();
+private:
+    Context*                                                m_Context;
+    std::array<FrameResources, Swapchain::FRAMES_IN_FLIGHT> m_Frames;
+};
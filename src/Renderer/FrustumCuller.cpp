@@ -0,0 +1,237 @@
+#include "Core/CnPch.hpp"
+#include "FrustumCuller.hpp"
+
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CN_FRUSTUM_SSE
+    #include <immintrin.h>
+#endif
+#if defined(__AVX__)
+    #define CN_FRUSTUM_AVX
+#endif
+
+void FrustumCuller::Clear()
+{
+    m_CenterX.clear();
+    m_CenterY.clear();
+    m_CenterZ.clear();
+    m_ExtentX.clear();
+    m_ExtentY.clear();
+    m_ExtentZ.clear();
+}
+
+void FrustumCuller::Reserve(size_t count)
+{
+    m_CenterX.reserve(count);
+    m_CenterY.reserve(count);
+    m_CenterZ.reserve(count);
+    m_ExtentX.reserve(count);
+    m_ExtentY.reserve(count);
+    m_ExtentZ.reserve(count);
+}
+
+uint32_t FrustumCuller::Add(const Bounds::AABB& aabb)
+{
+    glm::vec3 center = aabb.GetCenter();
+    glm::vec3 extent = aabb.GetExtent();
+
+    m_CenterX.push_back(center.x);
+    m_CenterY.push_back(center.y);
+    m_CenterZ.push_back(center.z);
+    m_ExtentX.push_back(extent.x);
+    m_ExtentY.push_back(extent.y);
+    m_ExtentZ.push_back(extent.z);
+
+    return GetCount() - 1;
+}
+
+FrustumCuller::Path FrustumCuller::GetBestPath()
+{
+#if defined(CN_FRUSTUM_AVX)
+    return Path::AVX;
+#elif defined(CN_FRUSTUM_SSE)
+    return Path::SSE;
+#else
+    return Path::Scalar;
+#endif
+}
+
+const char* FrustumCuller::GetPathName(Path path)
+{
+    switch(path)
+    {
+        case Path::SSE: return "SSE";
+        case Path::AVX: return "AVX";
+        default:        return "Scalar";
+    }
+}
+
+FrustumCuller::Planes FrustumCuller::ExtractPlanes(const glm::mat4& viewProjection)
+{
+    // Gribb-Hartmann like Culling.comp, the rows of the transposed matrix are the columns of viewProjection
+    glm::mat4 rows = glm::transpose(viewProjection);
+
+    Planes planes{};
+    planes.planes =
+            {
+                rows[3] + rows[0],
+                rows[3] - rows[0],
+                rows[3] + rows[1],
+                rows[3] - rows[1],
+                rows[3] + rows[2],
+                rows[3] - rows[2]
+            };
+    for(size_t i = 0; i < planes.planes.size(); i++)
+    {
+        planes.absNormals[i] = glm::abs(glm::vec3(planes.planes[i]));
+    }
+
+    return planes;
+}
+
+void FrustumCuller::Cull(const glm::mat4& viewProjection, std::vector<uint32_t>& visible, Path path) const
+{
+    CN_PROFILE_FUNCTION();
+
+    Planes planes = ExtractPlanes(viewProjection);
+
+    // Written through a raw pointer and trimmed afterwards, so the hot loop never checks capacity
+    visible.resize(m_CenterX.size());
+
+    // The SIMD paths leave the boxes past the last full batch to the scalar one
+    size_t visibleCount = 0;
+    size_t first = 0;
+#if defined(CN_FRUSTUM_AVX)
+    if(path == Path::AVX)
+    {
+        visibleCount = CullAVX(planes, visible.data());
+        first = m_CenterX.size() & ~size_t{7};
+    }
+#endif
+#if defined(CN_FRUSTUM_SSE)
+    if(path == Path::SSE)
+    {
+        visibleCount = CullSSE(planes, visible.data());
+        first = m_CenterX.size() & ~size_t{3};
+    }
+#endif
+    visibleCount += CullScalar(planes, first, visible.data() + visibleCount);
+
+    visible.resize(visibleCount);
+}
+
+size_t FrustumCuller::CullScalar(const Planes& planes, size_t first, uint32_t* visible) const
+{
+    size_t visibleCount = 0;
+    for(size_t i = first; i < m_CenterX.size(); i++)
+    {
+        // Planes stay unnormalized, only the sign of the distance matters
+        bool inside = true;
+        for(size_t p = 0; p < planes.planes.size() && inside; p++)
+        {
+            const glm::vec4& plane = planes.planes[p];
+            const glm::vec3& absNormal = planes.absNormals[p];
+
+            // Summed in the same order as the SIMD paths, so boxes touching a plane land on the same side
+            float distance = plane.w;
+            distance += m_CenterX[i] * plane.x;
+            distance += m_CenterY[i] * plane.y;
+            distance += m_CenterZ[i] * plane.z;
+            distance += m_ExtentX[i] * absNormal.x;
+            distance += m_ExtentY[i] * absNormal.y;
+            distance += m_ExtentZ[i] * absNormal.z;
+            inside = distance >= 0.0f;
+        }
+
+        if(inside)
+        {
+            visible[visibleCount++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    return visibleCount;
+}
+
+size_t FrustumCuller::CullSSE([[maybe_unused]] const Planes& planes, [[maybe_unused]] uint32_t* visible) const
+{
+    size_t visibleCount = 0;
+#if defined(CN_FRUSTUM_SSE)
+    size_t batchEnd = m_CenterX.size() & ~size_t{3};
+    for(size_t i = 0; i < batchEnd; i += 4)
+    {
+        __m128 centerX = _mm_loadu_ps(&m_CenterX[i]);
+        __m128 centerY = _mm_loadu_ps(&m_CenterY[i]);
+        __m128 centerZ = _mm_loadu_ps(&m_CenterZ[i]);
+        __m128 extentX = _mm_loadu_ps(&m_ExtentX[i]);
+        __m128 extentY = _mm_loadu_ps(&m_ExtentY[i]);
+        __m128 extentZ = _mm_loadu_ps(&m_ExtentZ[i]);
+
+        // All six planes are tested without early outs, a branch per plane costs more than the math
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for(size_t p = 0; p < planes.planes.size(); p++)
+        {
+            const glm::vec4& plane = planes.planes[p];
+            const glm::vec3& absNormal = planes.absNormals[p];
+
+            __m128 distance = _mm_set1_ps(plane.w);
+            distance = _mm_add_ps(distance, _mm_mul_ps(centerX, _mm_set1_ps(plane.x)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(centerY, _mm_set1_ps(plane.y)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(centerZ, _mm_set1_ps(plane.z)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(extentX, _mm_set1_ps(absNormal.x)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(extentY, _mm_set1_ps(absNormal.y)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(extentZ, _mm_set1_ps(absNormal.z)));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(inside));
+        while(mask != 0)
+        {
+            visible[visibleCount++] = static_cast<uint32_t>(i) + static_cast<uint32_t>(std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    return visibleCount;
+}
+
+size_t FrustumCuller::CullAVX([[maybe_unused]] const Planes& planes, [[maybe_unused]] uint32_t* visible) const
+{
+    size_t visibleCount = 0;
+#if defined(CN_FRUSTUM_AVX)
+    size_t batchEnd = m_CenterX.size() & ~size_t{7};
+    for(size_t i = 0; i < batchEnd; i += 8)
+    {
+        __m256 centerX = _mm256_loadu_ps(&m_CenterX[i]);
+        __m256 centerY = _mm256_loadu_ps(&m_CenterY[i]);
+        __m256 centerZ = _mm256_loadu_ps(&m_CenterZ[i]);
+        __m256 extentX = _mm256_loadu_ps(&m_ExtentX[i]);
+        __m256 extentY = _mm256_loadu_ps(&m_ExtentY[i]);
+        __m256 extentZ = _mm256_loadu_ps(&m_ExtentZ[i]);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for(size_t p = 0; p < planes.planes.size(); p++)
+        {
+            const glm::vec4& plane = planes.planes[p];
+            const glm::vec3& absNormal = planes.absNormals[p];
+
+            __m256 distance = _mm256_set1_ps(plane.w);
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(centerX, _mm256_set1_ps(plane.x)));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(centerY, _mm256_set1_ps(plane.y)));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(centerZ, _mm256_set1_ps(plane.z)));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(extentX, _mm256_set1_ps(absNormal.x)));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(extentY, _mm256_set1_ps(absNormal.y)));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(extentZ, _mm256_set1_ps(absNormal.z)));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(inside));
+        while(mask != 0)
+        {
+            visible[visibleCount++] = static_cast<uint32_t>(i) + static_cast<uint32_t>(std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    return visibleCount;
+}
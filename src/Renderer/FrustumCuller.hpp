@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Asset/Bounds.hpp"
+
+#include "glm/glm.hpp"
+
+// Tests world space boxes against the camera frustum on the CPU, for the draws the GPU does not cull.
+// Boxes are kept as structure of arrays so the SIMD paths load 4 (SSE) or 8 (AVX) of them per plane test.
+class FrustumCuller
+{
+public:
+    enum class Path
+    {
+        Scalar,
+        SSE,
+        AVX
+    };
+public:
+    FrustumCuller() = default;
+    ~FrustumCuller() = default;
+
+    FrustumCuller(const FrustumCuller& otherCuller) = delete;
+    FrustumCuller& operator=(const FrustumCuller& otherCuller) = delete;
+public:
+    void Clear();
+    void Reserve(size_t count);
+    // Returns the box's index, which is what Cull reports back
+    uint32_t Add(const Bounds::AABB& aabb);
+    // Overwrites visible with the indices of the boxes that intersect the frustum, in ascending order
+    void Cull(const glm::mat4& viewProjection, std::vector<uint32_t>& visible, Path path = GetBestPath()) const;
+public:
+    inline uint32_t GetCount() const { return static_cast<uint32_t>(m_CenterX.size()); }
+    // Widest path this binary was compiled for, AVX needs CONE_ENABLE_AVX
+    static Path GetBestPath();
+    static const char* GetPathName(Path path);
+private:
+    // Unnormalized planes as xyz normal and w distance, plus the absolute normal for the extent term
+    struct Planes
+    {
+        std::array<glm::vec4, 6> planes;
+        std::array<glm::vec3, 6> absNormals;
+    };
+private:
+    static Planes ExtractPlanes(const glm::mat4& viewProjection);
+    size_t CullScalar(const Planes& planes, size_t first, uint32_t* visible) const;
+    size_t CullSSE(const Planes& planes, uint32_t* visible) const;
+    size_t CullAVX(const Planes& planes, uint32_t* visible) const;
+private:
+    std::vector<float>  m_CenterX;
+    std::vector<float>  m_CenterY;
+    std::vector<float>  m_CenterZ;
+    std::vector<float>  m_ExtentX;
+    std::vector<float>  m_ExtentY;
+    std::vector<float>  m_ExtentZ;
+};
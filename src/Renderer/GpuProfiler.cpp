@@ -0,0 +1,234 @@
+#include "Core/CnPch.hpp"
+#include "GpuProfiler.hpp"
+
+#include "Context.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+GpuProfiler::GpuProfiler(Context* context)
+    :   m_Context{context}, m_Supported{false}, m_TimestampPeriod{0.0}, m_TimestampMask{0}, m_FrameIndex{0},
+        m_QueryPools{}, m_QueryCounts{}, m_LastLog{std::chrono::steady_clock::now()}
+{
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(m_Context->GetPhysicalDevice(), &properties);
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(m_Context->GetPhysicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(m_Context->GetPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+    uint32_t validBits  = queueFamilies[m_Context->GetGraphicsQueueFamily()].timestampValidBits;
+    m_TimestampPeriod   = static_cast<double>(properties.limits.timestampPeriod);
+    m_TimestampMask     = validBits >= 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t{1} << validBits) - 1;
+    m_Supported         = validBits != 0 && m_TimestampPeriod > 0.0;
+
+    if(!m_Supported)
+    {
+        std::cout << "[Cone] GPU timestamps are not supported on the graphics queue, profiling disabled" << std::endl;
+        return;
+    }
+
+    CreateQueryPools();
+    m_Timestamps.resize(MAX_QUERIES_PER_FRAME);
+}
+
+void GpuProfiler::CreateQueryPools()
+{
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType         = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType     = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount    = MAX_QUERIES_PER_FRAME;
+
+    for(VkQueryPool& queryPool : m_QueryPools)
+    {
+        VK_CHECK(vkCreateQueryPool(m_Context->GetLogicalDevice(), &queryPoolInfo, nullptr, &queryPool))
+    }
+}
+
+void GpuProfiler::BeginFrame(VkCommandBuffer commandBuffer, size_t frameIndex)
+{
+    m_FrameIndex = frameIndex;
+    if(!m_Supported)
+    {
+        return;
+    }
+
+    CollectResults(frameIndex);
+
+    vkCmdResetQueryPool(commandBuffer, m_QueryPools[frameIndex], 0, MAX_QUERIES_PER_FRAME);
+    m_QueryCounts[frameIndex] = 0;
+    m_PendingScopes[frameIndex].clear();
+    m_OpenScopes.clear();
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if(std::chrono::duration<double>(now - m_LastLog).count() >= LOG_INTERVAL_SECONDS)
+    {
+        LogStats();
+        m_LastLog = now;
+    }
+
+    BeginScope(commandBuffer, "Frame");
+}
+
+void GpuProfiler::EndFrame(VkCommandBuffer commandBuffer)
+{
+    // Closes the frame scope and anything a pass left open
+    while(!m_OpenScopes.empty())
+    {
+        EndScope(commandBuffer);
+    }
+}
+
+void GpuProfiler::BeginScope(VkCommandBuffer commandBuffer, std::string_view name)
+{
+    if(!m_Supported)
+    {
+        return;
+    }
+
+    uint32_t& queryCount = m_QueryCounts[m_FrameIndex];
+    if(queryCount + 2 > MAX_QUERIES_PER_FRAME)
+    {
+        // Out of queries, the scope is still tracked so EndScope stays balanced
+        m_OpenScopes.push_back(std::numeric_limits<size_t>::max());
+        return;
+    }
+
+    PendingScope scope{};
+    scope.statIndex     = GetStatIndex(name);
+    scope.beginQuery    = queryCount;
+    scope.endQuery      = queryCount + 1;
+    queryCount += 2;
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_QueryPools[m_FrameIndex], scope.beginQuery);
+
+    m_OpenScopes.push_back(m_PendingScopes[m_FrameIndex].size());
+    m_PendingScopes[m_FrameIndex].push_back(scope);
+}
+
+void GpuProfiler::EndScope(VkCommandBuffer commandBuffer)
+{
+    if(!m_Supported || m_OpenScopes.empty())
+    {
+        return;
+    }
+
+    size_t pendingIndex = m_OpenScopes.back();
+    m_OpenScopes.pop_back();
+    if(pendingIndex == std::numeric_limits<size_t>::max())
+    {
+        return;
+    }
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_QueryPools[m_FrameIndex], m_PendingScopes[m_FrameIndex][pendingIndex].endQuery);
+}
+
+void GpuProfiler::CollectResults(size_t frameIndex)
+{
+    uint32_t queryCount = m_QueryCounts[frameIndex];
+    if(queryCount == 0)
+    {
+        return;
+    }
+
+    // The fence of this slot was waited on, so no VK_QUERY_RESULT_WAIT_BIT and no stall
+    VkResult result = vkGetQueryPoolResults(m_Context->GetLogicalDevice(), m_QueryPools[frameIndex], 0, queryCount,
+                                            queryCount * sizeof(uint64_t), m_Timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if(result != VK_SUCCESS)
+    {
+        return;
+    }
+
+    for(const PendingScope& scope : m_PendingScopes[frameIndex])
+    {
+        uint64_t ticks = (m_Timestamps[scope.endQuery] - m_Timestamps[scope.beginQuery]) & m_TimestampMask;
+        UpdateStats(scope.statIndex, static_cast<double>(ticks) * m_TimestampPeriod / 1'000'000.0);
+    }
+}
+
+void GpuProfiler::UpdateStats(size_t statIndex, double milliseconds)
+{
+    ScopeHistory& history = m_Histories[statIndex];
+    history.samples[history.next] = milliseconds;
+    history.next  = (history.next + 1) % HISTORY_SIZE;
+    history.count = std::min(history.count + 1, HISTORY_SIZE);
+
+    // Scratch storage is reused so steady state frames do not allocate
+    std::vector<double>& sorted = m_SortScratch;
+    sorted.assign(history.samples.begin(), history.samples.begin() + history.count);
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0.0;
+    for(double sample : sorted)
+    {
+        sum += sample;
+    }
+
+    ScopeStats& stats   = m_Stats[statIndex];
+    stats.lastMs        = milliseconds;
+    stats.minMs         = sorted.front();
+    stats.avgMs         = sum / static_cast<double>(sorted.size());
+    stats.p99Ms         = sorted[static_cast<size_t>(std::ceil(0.99 * static_cast<double>(sorted.size()))) - 1];
+    stats.sampleCount++;
+}
+
+size_t GpuProfiler::GetStatIndex(std::string_view name)
+{
+    for(size_t i = 0; i < m_Stats.size(); i++)
+    {
+        if(m_Stats[i].name == name)
+        {
+            return i;
+        }
+    }
+
+    ScopeStats stats{};
+    stats.name = std::string(name);
+    m_Stats.push_back(stats);
+    m_Histories.emplace_back();
+
+    return m_Stats.size() - 1;
+}
+
+const GpuProfiler::ScopeStats* GpuProfiler::FindStats(std::string_view name) const
+{
+    for(const ScopeStats& stats : m_Stats)
+    {
+        if(stats.name == name)
+        {
+            return &stats;
+        }
+    }
+
+    return nullptr;
+}
+
+void GpuProfiler::LogStats() const
+{
+    if(m_Stats.empty() || m_Stats.front().sampleCount == 0)
+    {
+        return;
+    }
+
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(2) << "[Cone] GPU";
+    for(const ScopeStats& stats : m_Stats)
+    {
+        line << " | " << stats.name << " avg " << stats.avgMs << " ms (min " << stats.minMs << ", p99 " << stats.p99Ms << ")";
+    }
+
+    std::cout << line.str() << std::endl;
+}
+
+GpuProfiler::~GpuProfiler()
+{
+    for(VkQueryPool queryPool : m_QueryPools)
+    {
+        if(queryPool)
+        {
+            vkDestroyQueryPool(m_Context->GetLogicalDevice(), queryPool, nullptr);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Swapchain.hpp"
+
+#include <chrono>
+
+class Context;
+
+class GpuProfiler
+{
+public:
+    struct ScopeStats
+    {
+        std::string     name;
+        double          lastMs{0.0};
+        double          minMs{0.0};
+        double          avgMs{0.0};
+        double          p99Ms{0.0};
+        uint32_t        sampleCount{0};
+    };
+public:
+    explicit GpuProfiler(Context* context);
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler& otherProfiler) = delete;
+    GpuProfiler& operator=(const GpuProfiler& otherProfiler) = delete;
+public:
+    // Has to follow the wait on the frame's fence, the previous results of the slot are read back here
+    void BeginFrame(VkCommandBuffer commandBuffer, size_t frameIndex);
+    void EndFrame(VkCommandBuffer commandBuffer);
+    void BeginScope(VkCommandBuffer commandBuffer, std::string_view name);
+    void EndScope(VkCommandBuffer commandBuffer);
+    void LogStats() const;
+    // Null until a scope of that name was recorded
+    const ScopeStats* FindStats(std::string_view name) const;
+public:
+    // Ordered by first appearance, the frame itself comes first
+    inline const std::vector<ScopeStats>& GetStats() const { return m_Stats; }
+    inline bool IsSupported() const { return m_Supported; }
+    inline static constexpr uint32_t MAX_QUERIES_PER_FRAME = 64;
+    inline static constexpr uint32_t HISTORY_SIZE = 256;
+    inline static constexpr double LOG_INTERVAL_SECONDS = 5.0;
+private:
+    struct PendingScope
+    {
+        size_t      statIndex;
+        uint32_t    beginQuery;
+        uint32_t    endQuery;
+    };
+    struct ScopeHistory
+    {
+        std::array<double, HISTORY_SIZE>    samples{};
+        uint32_t                            next{0};
+        uint32_t                            count{0};
+    };
+private:
+    void CreateQueryPools();
+    void CollectResults(size_t frameIndex);
+    void UpdateStats(size_t statIndex, double milliseconds);
+    size_t GetStatIndex(std::string_view name);
+private:
+    Context*                                                        m_Context;
+    bool                                                            m_Supported;
+    double                                                          m_TimestampPeriod;
+    uint64_t                                                        m_TimestampMask;
+    size_t                                                          m_FrameIndex;
+    std::array<VkQueryPool, Swapchain::FRAMES_IN_FLIGHT>            m_QueryPools;
+    std::array<uint32_t, Swapchain::FRAMES_IN_FLIGHT>               m_QueryCounts;
+    std::array<std::vector<PendingScope>, Swapchain::FRAMES_IN_FLIGHT>  m_PendingScopes;
+    std::vector<size_t>                                             m_OpenScopes;
+    std::vector<ScopeStats>                                         m_Stats;
+    std::vector<ScopeHistory>                                       m_Histories;
+    std::vector<uint64_t>                                           m_Timestamps;
+    std::vector<double>                                             m_SortScratch;
+    std::chrono::steady_clock::time_point                           m_LastLog;
+};
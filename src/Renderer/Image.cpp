@@ -2,22 +2,42 @@
 #include "Image.hpp"
 
 #include "Context.hpp"
+#include "BarrierBatch.hpp"
 #include "Buffer/Buffer.hpp"
 
 Image::Image(Context* context, const ImageInfo& imageInfo)
-    :   m_Context{context}, m_Image{}, m_ImageView{},
-        m_ImageLayout{VK_IMAGE_LAYOUT_UNDEFINED}, m_ImageFormat{imageInfo.format},
+    :   m_Context{context}, m_Image{}, m_ImageView{}, m_ImageFormat{imageInfo.format},
         m_ImageDimension{imageInfo.dimension}, m_GenMipmaps{imageInfo.genMipmaps}, m_ImageMipLevels{1}, m_UsageFlags{imageInfo.usageFlags},
-        m_AspectFlags{imageInfo.aspectFlags}, m_Allocation{}, m_AllocationInfo{}
+        m_AspectFlags{imageInfo.aspectFlags}, m_Allocation{}, m_AllocationInfo{}, m_OwnsImage{true}
 {
     CreateImage();
     CreateImageView();
+    SetHostSynchronizedLayout(VK_IMAGE_LAYOUT_UNDEFINED);
     ChangeLayout(imageInfo.desiredLayout);
 }
 
+Image::Image(Context* context, const ExternalImageInfo& externalInfo)
+    :   m_Context{context}, m_Image{externalInfo.image}, m_ImageView{externalInfo.imageView}, m_ImageFormat{externalInfo.format},
+        m_ImageDimension{externalInfo.dimension}, m_GenMipmaps{VK_FALSE}, m_ImageMipLevels{1}, m_UsageFlags{},
+        m_AspectFlags{externalInfo.aspectFlags}, m_Allocation{}, m_AllocationInfo{}, m_OwnsImage{false}
+{
+    m_SubresourceStates.assign(m_ImageMipLevels, externalInfo.initialState);
+}
+
+Image::Image(Context* context, const ImageInfo& imageInfo, VmaAllocation aliasedMemory)
+    :   m_Context{context}, m_Image{}, m_ImageView{}, m_ImageFormat{imageInfo.format},
+        m_ImageDimension{imageInfo.dimension}, m_GenMipmaps{VK_FALSE}, m_ImageMipLevels{1}, m_UsageFlags{imageInfo.usageFlags},
+        m_AspectFlags{imageInfo.aspectFlags}, m_Allocation{}, m_AllocationInfo{}, m_OwnsImage{true}
+{
+    CreateAliasingImage(aliasedMemory);
+    CreateImageView();
+    // No transition here, another image may still be using the memory
+    SetHostSynchronizedLayout(VK_IMAGE_LAYOUT_UNDEFINED);
+}
+
 void Image::ChangeLayout(VkImageLayout newLayout, VkPipelineStageFlags sourceFlags)
 {
-    if(m_ImageLayout == newLayout)
+    if(GetImageLayout() == newLayout)
     {
         return;
     }
@@ -25,7 +45,7 @@ void Image::ChangeLayout(VkImageLayout newLayout, VkPipelineStageFlags sourceFla
     VkCommandBuffer commandBuffer = m_Context->BeginSingleTimeCommands(Context::CommandType::GRAPHICS);
 
     Utilities::LayoutTransitionInfo transitionInfo{};
-    transitionInfo.oldLayout        = m_ImageLayout;
+    transitionInfo.oldLayout        = GetImageLayout();
     transitionInfo.newLayout        = newLayout;
     transitionInfo.image            = m_Image;
     transitionInfo.mipLevels        = m_ImageMipLevels;
@@ -35,7 +55,101 @@ void Image::ChangeLayout(VkImageLayout newLayout, VkPipelineStageFlags sourceFla
     Utilities::ChangeLayout(commandBuffer, transitionInfo);
     m_Context->EndSingleTimeCommands(Context::CommandType::GRAPHICS, commandBuffer);
 
-    m_ImageLayout = newLayout;
+    SetHostSynchronizedLayout(newLayout);
+}
+
+void Image::ChangeLayout(BarrierBatch& batch, VkImageLayout newLayout)
+{
+    Utilities::ImageSyncState scope = Utilities::GetImageSyncState(newLayout);
+    ChangeLayout(batch, newLayout, scope.stageMask, scope.accessMask);
+}
+
+void Image::ChangeLayout(BarrierBatch& batch, VkImageLayout newLayout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask,
+                         uint32_t baseMipLevel, uint32_t levelCount)
+{
+    const uint32_t endMipLevel = levelCount == VK_REMAINING_MIP_LEVELS ? m_ImageMipLevels : baseMipLevel + levelCount;
+    const Utilities::ImageSyncState nextState{ newLayout, stageMask, accessMask };
+
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image                           = m_Image;
+    barrier.subresourceRange.aspectMask     = m_AspectFlags;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount     = 1;
+
+    bool pendingBarrier = false;
+    for(uint32_t mip = baseMipLevel; mip < endMipLevel; mip++)
+    {
+        Utilities::ImageSyncState& state = m_SubresourceStates[mip];
+
+        if(!Utilities::NeedsBarrier(state, nextState))
+        {
+            // Concurrent reads, later writers have to wait on every reader
+            state.stageMask     |= stageMask;
+            state.accessMask    |= accessMask;
+            continue;
+        }
+
+        // Only writes need to be made available, read hazards need just an execution dependency
+        VkAccessFlags2 srcAccessMask = Utilities::IsWriteAccess(state.accessMask) ? state.accessMask : VK_ACCESS_2_NONE;
+
+        // Neighbouring mips coming from the same state share a single barrier
+        bool extendsPending = pendingBarrier &&
+                barrier.subresourceRange.baseMipLevel + barrier.subresourceRange.levelCount == mip &&
+                barrier.oldLayout == state.layout && barrier.srcStageMask == state.stageMask && barrier.srcAccessMask == srcAccessMask;
+
+        if(extendsPending)
+        {
+            barrier.subresourceRange.levelCount++;
+        } else
+        {
+            if(pendingBarrier)
+            {
+                batch.AddImageBarrier(barrier);
+            }
+
+            barrier.srcStageMask                    = state.stageMask;
+            barrier.srcAccessMask                   = srcAccessMask;
+            barrier.dstStageMask                    = stageMask;
+            barrier.dstAccessMask                   = accessMask;
+            barrier.oldLayout                       = state.layout;
+            barrier.newLayout                       = newLayout;
+            barrier.subresourceRange.baseMipLevel   = mip;
+            barrier.subresourceRange.levelCount     = 1;
+            pendingBarrier = true;
+        }
+
+        state = nextState;
+    }
+
+    if(pendingBarrier)
+    {
+        batch.AddImageBarrier(barrier);
+    }
+}
+
+void Image::DiscardContents()
+{
+    // The next transition starts from UNDEFINED but still waits on the last users
+    for(Utilities::ImageSyncState& state : m_SubresourceStates)
+    {
+        state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+}
+
+void Image::AliasAfter(const Image& previousOccupant)
+{
+    // The memory was last used through another image, so the next barrier has to wait on that image's users instead
+    Utilities::ImageSyncState aliasState{ VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE };
+    for(const Utilities::ImageSyncState& state : previousOccupant.m_SubresourceStates)
+    {
+        aliasState.stageMask    |= state.stageMask;
+        aliasState.accessMask   |= state.accessMask;
+    }
+
+    m_SubresourceStates.assign(m_ImageMipLevels, aliasState);
 }
 
 void Image::CopyDataToImage(const Buffer* buffer, const VkExtent3D imageExtent)
@@ -75,26 +189,61 @@ void Image::CreateImage()
         m_UsageFlags |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
     }
 
+    VkImageCreateInfo imageCreateInfo = GetImageCreateInfo(m_ImageFormat, m_ImageDimension, m_ImageMipLevels, m_UsageFlags);
+
+    VmaAllocationCreateInfo vmaAllocationCreateInfo{};
+    vmaAllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    vmaAllocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    VK_CHECK(vmaCreateImage(m_Context->GetAllocator(), &imageCreateInfo, &vmaAllocationCreateInfo, &m_Image, &m_Allocation, &m_AllocationInfo))
+}
+
+void Image::CreateAliasingImage(VmaAllocation aliasedMemory)
+{
+    VkImageCreateInfo imageCreateInfo = GetImageCreateInfo(m_ImageFormat, m_ImageDimension, m_ImageMipLevels, m_UsageFlags);
+
+    // m_Allocation stays empty, so destroying the image leaves the shared memory alone
+    VK_CHECK(vmaCreateAliasingImage(m_Context->GetAllocator(), aliasedMemory, &imageCreateInfo, &m_Image))
+}
+
+VkImageCreateInfo Image::GetImageCreateInfo(VkFormat format, VkExtent2D dimension, uint32_t mipLevels, VkImageUsageFlags usageFlags)
+{
     VkImageCreateInfo imageCreateInfo{};
     imageCreateInfo.sType           = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageCreateInfo.imageType       = VK_IMAGE_TYPE_2D;
-    imageCreateInfo.format          = m_ImageFormat;
-    imageCreateInfo.extent.width    = m_ImageDimension.width;
-    imageCreateInfo.extent.height   = m_ImageDimension.height;
+    imageCreateInfo.format          = format;
+    imageCreateInfo.extent.width    = dimension.width;
+    imageCreateInfo.extent.height   = dimension.height;
     imageCreateInfo.extent.depth    = 1U;
-    imageCreateInfo.mipLevels       = m_ImageMipLevels;
+    imageCreateInfo.mipLevels       = mipLevels;
     imageCreateInfo.arrayLayers     = 1U;
     imageCreateInfo.samples         = VK_SAMPLE_COUNT_1_BIT;
     imageCreateInfo.tiling          = VK_IMAGE_TILING_OPTIMAL;
-    imageCreateInfo.usage           = m_UsageFlags;
+    imageCreateInfo.usage           = usageFlags;
     imageCreateInfo.sharingMode     = VK_SHARING_MODE_EXCLUSIVE;
-    imageCreateInfo.initialLayout   = m_ImageLayout;
+    imageCreateInfo.initialLayout   = VK_IMAGE_LAYOUT_UNDEFINED;
 
-    VmaAllocationCreateInfo vmaAllocationCreateInfo{};
-    vmaAllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
-    vmaAllocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    return imageCreateInfo;
+}
 
-    VK_CHECK(vmaCreateImage(m_Context->GetAllocator(), &imageCreateInfo, &vmaAllocationCreateInfo, &m_Image, &m_Allocation, &m_AllocationInfo))
+VkMemoryRequirements Image::GetMemoryRequirements(Context* context, const ImageInfo& imageInfo)
+{
+    if(imageInfo.genMipmaps == VK_TRUE)
+    {
+        throw std::runtime_error("Error: Memory requirements are only queried for single mip images.");
+    }
+
+    // Throwaway image, the requirements are only known once a handle exists
+    VkImageCreateInfo imageCreateInfo = GetImageCreateInfo(imageInfo.format, imageInfo.dimension, 1U, imageInfo.usageFlags);
+
+    VkImage probeImage{};
+    VK_CHECK(vkCreateImage(context->GetLogicalDevice(), &imageCreateInfo, nullptr, &probeImage))
+
+    VkMemoryRequirements memoryRequirements{};
+    vkGetImageMemoryRequirements(context->GetLogicalDevice(), probeImage, &memoryRequirements);
+    vkDestroyImage(context->GetLogicalDevice(), probeImage, nullptr);
+
+    return memoryRequirements;
 }
 
 void Image::CreateImageView()
@@ -209,11 +358,22 @@ void Image::GenerateMipmaps(VkImageLayout finalLayout)
 
     m_Context->EndSingleTimeCommands(Context::CommandType::GRAPHICS, commandBuffer);
 
-    m_ImageLayout = finalLayout;
+    SetHostSynchronizedLayout(finalLayout);
+}
+
+void Image::SetHostSynchronizedLayout(VkImageLayout layout)
+{
+    // Single time commands wait for the queue to idle, so no device work is left to synchronize with
+    m_SubresourceStates.assign(m_ImageMipLevels, { layout, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE });
 }
 
 Image::~Image()
 {
+    if(!m_OwnsImage)
+    {
+        return;
+    }
+
     if(m_ImageView)
     {
         vkDestroyImageView(m_Context->GetLogicalDevice(), m_ImageView, nullptr);
@@ -2,6 +2,7 @@
 
 class Context;
 class Buffer;
+class BarrierBatch;
 
 class Image
 {
@@ -15,8 +16,21 @@ public:
         VkImageAspectFlags  aspectFlags;
         VkBool32            genMipmaps;
     };
+    struct ExternalImageInfo
+    {
+        VkImage                     image;
+        VkImageView                 imageView;
+        VkFormat                    format;
+        VkExtent2D                  dimension;
+        VkImageAspectFlags          aspectFlags;
+        Utilities::ImageSyncState   initialState;
+    };
 public:
     Image(Context* context, const ImageInfo& imageInfo);
+    // Wraps an image owned elsewhere (e.g. by the swapchain) so its state can be tracked
+    Image(Context* context, const ExternalImageInfo& externalInfo);
+    // Binds to memory owned by the caller, which may be shared with other images
+    Image(Context* context, const ImageInfo& imageInfo, VmaAllocation aliasedMemory);
     ~Image();
 
     Image(Image&&) noexcept = default;
@@ -26,21 +40,34 @@ public:
     Image& operator=(const Image& otherAttachment) = delete;
 public:
     void ChangeLayout(VkImageLayout newLayout, VkPipelineStageFlags sourceFlags = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    void ChangeLayout(BarrierBatch& batch, VkImageLayout newLayout);
+    void ChangeLayout(BarrierBatch& batch, VkImageLayout newLayout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask,
+                      uint32_t baseMipLevel = 0, uint32_t levelCount = VK_REMAINING_MIP_LEVELS);
+    void DiscardContents();
     void CopyDataToImage(const Buffer* buffer, VkExtent3D imageExtent);
     void GenerateMipmaps(VkImageLayout finalLayout);
+    void AliasAfter(const Image& previousOccupant);
 public:
+    static VkMemoryRequirements GetMemoryRequirements(Context* context, const ImageInfo& imageInfo);
+public:
+    inline VkImage GetImage() const { return m_Image; }
     inline VkImageView GetImageView() const { return m_ImageView; }
-    inline VkImageLayout GetImageLayout() const { return m_ImageLayout; }
+    inline uint32_t GetMipLevels() const { return m_ImageMipLevels; }
+    inline VkImageLayout GetImageLayout(uint32_t mipLevel = 0) const { return m_SubresourceStates[mipLevel].layout; }
+    inline const Utilities::ImageSyncState& GetSyncState(uint32_t mipLevel = 0) const { return m_SubresourceStates[mipLevel]; }
     inline VkFormat GetImageFormat() const { return m_ImageFormat; }
+    inline VkExtent2D GetDimension() const { return m_ImageDimension; }
     inline float GetMaxLOD() const { return m_GenMipmaps == VK_TRUE ? static_cast<float>(m_ImageMipLevels) : 0.0f; }
 private:
     void CreateImage();
+    void CreateAliasingImage(VmaAllocation aliasedMemory);
     void CreateImageView();
+    static VkImageCreateInfo GetImageCreateInfo(VkFormat format, VkExtent2D dimension, uint32_t mipLevels, VkImageUsageFlags usageFlags);
+    void SetHostSynchronizedLayout(VkImageLayout layout);
 private:
     Context*            m_Context;
     VkImage             m_Image;
     VkImageView         m_ImageView;
-    VkImageLayout       m_ImageLayout;
     VkFormat            m_ImageFormat;
     VkExtent2D          m_ImageDimension;
     VkBool32            m_GenMipmaps;
@@ -49,4 +76,8 @@ private:
     VkImageAspectFlags  m_AspectFlags;
     VmaAllocation       m_Allocation;
     VmaAllocationInfo   m_AllocationInfo;
+    bool                m_OwnsImage;
+private:
+    // Indexed by mip level
+    std::vector<Utilities::ImageSyncState> m_SubresourceStates;
 };
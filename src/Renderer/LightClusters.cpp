@@ -0,0 +1,139 @@
+#include "Core/CnPch.hpp"
+#include "LightClusters.hpp"
+
+#include "Context.hpp"
+#include "RenderPacket.hpp"
+#include "Scene/Camera.hpp"
+
+LightClusters::LightClusters(Context* context, VkExtent2D screenSize, GpuProfiler* profiler, CommandRecorder* recorder)
+    :   m_Context{context}, m_ScreenSize{screenSize}
+{
+    for(size_t i = 0; i < m_Frames.size(); i++)
+    {
+        CreateFrameResources(i, INITIAL_LIGHT_CAPACITY);
+    }
+    CreatePipeline(profiler, recorder);
+}
+
+void LightClusters::CreateFrameResources(size_t frameIndex, uint32_t lightCapacity)
+{
+    FrameResources& frame = m_Frames[frameIndex];
+    frame.lightCapacity = lightCapacity;
+
+    Buffer::BufferInfo paramsInfo{};
+    paramsInfo.size             = sizeof(ClusterParams);
+    paramsInfo.usageFlags       = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    paramsInfo.vmaMemoryUsage   = VMA_MEMORY_USAGE_AUTO;
+    paramsInfo.vmaAllocFlags    = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    Buffer::BufferInfo lightInfo{};
+    lightInfo.size              = static_cast<VkDeviceSize>(lightCapacity) * sizeof(Lights::PointLight);
+    lightInfo.usageFlags        = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    lightInfo.vmaMemoryUsage    = VMA_MEMORY_USAGE_AUTO;
+    lightInfo.vmaAllocFlags     = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    // Only ever written by the light culling pass
+    Buffer::BufferInfo clusterInfo{};
+    clusterInfo.size            = static_cast<VkDeviceSize>(CLUSTER_COUNT) * (1 + MAX_LIGHTS_PER_CLUSTER) * sizeof(uint32_t);
+    clusterInfo.usageFlags      = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    clusterInfo.vmaMemoryUsage  = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    clusterInfo.vmaAllocFlags   = 0;
+
+    frame.paramsBuffer  = std::make_unique<Buffer>(m_Context, paramsInfo);
+    frame.lightBuffer   = std::make_unique<Buffer>(m_Context, lightInfo);
+    frame.clusterBuffer = std::make_unique<Buffer>(m_Context, clusterInfo);
+
+    std::array<Buffer*, 3> buffers = { frame.paramsBuffer.get(), frame.lightBuffer.get(), frame.clusterBuffer.get() };
+    std::array<VkDescriptorBufferInfo, 3> bufferInfos{};
+    std::vector<DescriptorSet::BindingInfo> bindings;
+
+    for(size_t i = 0; i < buffers.size(); i++)
+    {
+        bufferInfos[i].buffer   = buffers[i]->GetBuffer();
+        bufferInfos[i].offset   = 0;
+        bufferInfos[i].range    = VK_WHOLE_SIZE;
+
+        // The light culling pass writes the clusters, the lighting pass reads all three.
+        // Light volumes place their instances from the light buffer in the vertex shader
+        DescriptorSet::BindingInfo bindingInfo{};
+        bindingInfo.type        = i == 0 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindingInfo.binding     = static_cast<uint32_t>(i);
+        bindingInfo.stageFlags  = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        bindingInfo.bufferInfo  = &bufferInfos[i];
+        bindings.push_back(bindingInfo);
+    }
+
+    frame.descriptorSet = std::make_unique<DescriptorSet>(m_Context, bindings);
+}
+
+void LightClusters::CreatePipeline(GpuProfiler* profiler, CommandRecorder* recorder)
+{
+    ComputePipeline::PipelineInfo pipeInfo{};
+    pipeInfo.computePath    = "/Shaders/LightCullingComp.spv";
+    pipeInfo.layouts        = { GetDescriptorSetLayout() };
+
+    pipeInfo.name           = "LightCulling";
+    pipeInfo.profiler       = profiler;
+    pipeInfo.recorder       = recorder;
+
+    m_Pipeline = std::make_unique<ComputePipeline>(m_Context, pipeInfo);
+}
+
+void LightClusters::Update(const RenderPacket& packet, size_t frameIndex)
+{
+    CN_PROFILE_FUNCTION();
+
+    uint32_t lightCount = static_cast<uint32_t>(packet.pointLights.size());
+    FrameResources& frame = m_Frames[frameIndex];
+    if(lightCount > frame.lightCapacity)
+    {
+        uint32_t capacity = frame.lightCapacity;
+        while(capacity < lightCount)
+        {
+            capacity *= 2;
+        }
+
+        // Nothing else reads this slot's buffers, its previous submission is complete
+        CreateFrameResources(frameIndex, capacity);
+    }
+
+    ClusterParams params{};
+    params.viewMatrix            = packet.camera.viewMatrix;
+    params.inverseProjection     = glm::inverse(packet.camera.projectionMatrix);
+    params.screenSize            = glm::vec2(m_ScreenSize.width, m_ScreenSize.height);
+    params.nearPlane             = Camera::NEAR_PLANE;
+    params.farPlane              = Camera::FAR_PLANE;
+    params.viewPos               = packet.cameraPosition;
+    params.lightCount            = lightCount;
+    params.inverseViewProjection = glm::inverse(packet.camera.viewProjectionMatrix);
+    frame.paramsBuffer->Map(&params, sizeof(ClusterParams));
+
+    if(lightCount != 0)
+    {
+        frame.lightBuffer->Map(packet.pointLights.data(), packet.pointLights.size() * sizeof(Lights::PointLight));
+    }
+}
+
+void LightClusters::Build(VkCommandBuffer commandBuffer, size_t frameIndex)
+{
+    // The slot's previous lighting pass is complete, so the clusters can be overwritten without a barrier
+    m_Pipeline->Begin(commandBuffer);
+    m_Pipeline->BindDescriptorSet(GetDescriptorSet(frameIndex), 0U);
+    // One invocation per cluster, 64 per group, see LightCulling.comp
+    m_Pipeline->Dispatch((CLUSTER_COUNT + 63) / 64);
+    m_Pipeline->End();
+
+    VkBufferMemoryBarrier2 clusterBarrier{};
+    clusterBarrier.sType                = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    clusterBarrier.srcStageMask         = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    clusterBarrier.srcAccessMask        = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    clusterBarrier.dstStageMask         = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+    clusterBarrier.dstAccessMask        = VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+    clusterBarrier.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+    clusterBarrier.dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED;
+    clusterBarrier.buffer               = m_Frames[frameIndex].clusterBuffer->GetBuffer();
+    clusterBarrier.offset               = 0;
+    clusterBarrier.size                 = VK_WHOLE_SIZE;
+    m_BarrierBatch.AddBufferBarrier(clusterBarrier);
+    m_BarrierBatch.Flush(commandBuffer);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Swapchain.hpp"
+#include "BarrierBatch.hpp"
+#include "ComputePipeline.hpp"
+#include "DescriptorSet.hpp"
+#include "Buffer/Buffer.hpp"
+
+#include "glm/glm.hpp"
+
+class Context;
+class GpuProfiler;
+struct RenderPacket;
+
+// Bins the point lights of a render packet into a froxel grid: GRID_X x GRID_Y screen tiles, each cut into GRID_Z
+// view space depth slices spaced exponentially between the camera's near and far plane.
+// LightCulling.comp lists up to MAX_LIGHTS_PER_CLUSTER lights per cluster, Lighting.frag only shades the lights
+// of the cluster its pixel falls into. Lights live in a storage buffer that grows with the scene, which the light
+// volume path draws its instances from as well.
+class LightClusters
+{
+public:
+    // Matches ClusterParams in LightCulling.comp, Lighting.frag and LightVolume.frag (std140)
+    struct ClusterParams
+    {
+        glm::mat4   viewMatrix;
+        glm::mat4   inverseProjection;
+        glm::vec2   screenSize;
+        float       nearPlane;
+        float       farPlane;
+        glm::vec3   viewPos;
+        uint32_t    lightCount;
+        // Brings depth back to world space for the compact G-buffer
+        glm::mat4   inverseViewProjection;
+    };
+public:
+    LightClusters(Context* context, VkExtent2D screenSize, GpuProfiler* profiler, CommandRecorder* recorder);
+    ~LightClusters() = default;
+
+    LightClusters(const LightClusters& otherClusters) = delete;
+    LightClusters& operator=(const LightClusters& otherClusters) = delete;
+public:
+    // Rewrites the buffers of this frame slot, its previous submission has to be complete
+    void Update(const RenderPacket& packet, size_t frameIndex);
+    // Leaves the cluster lists readable by fragment shaders
+    void Build(VkCommandBuffer commandBuffer, size_t frameIndex);
+public:
+    inline VkDescriptorSet GetDescriptorSet(size_t frameIndex) const { return m_Frames[frameIndex].descriptorSet->GetDescriptorSet(); }
+    inline VkDescriptorSetLayout GetDescriptorSetLayout() const { return m_Frames[0].descriptorSet->GetDescriptorSetLayout(); }
+    // Has to match the defines in LightCulling.comp and Lighting.frag
+    inline static constexpr uint32_t GRID_X                 = 16;
+    inline static constexpr uint32_t GRID_Y                 = 9;
+    inline static constexpr uint32_t GRID_Z                 = 24;
+    inline static constexpr uint32_t CLUSTER_COUNT          = GRID_X * GRID_Y * GRID_Z;
+    inline static constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 128;
+    inline static constexpr uint32_t INITIAL_LIGHT_CAPACITY = 1024;
+private:
+    struct FrameResources
+    {
+        std::unique_ptr<Buffer>         paramsBuffer;
+        std::unique_ptr<Buffer>         lightBuffer;
+        // Light count of every cluster followed by MAX_LIGHTS_PER_CLUSTER light indices per cluster
+        std::unique_ptr<Buffer>         clusterBuffer;
+        std::unique_ptr<DescriptorSet>  descriptorSet;
+        uint32_t                        lightCapacity;
+    };
+private:
+    void CreateFrameResources(size_t frameIndex, uint32_t lightCapacity);
+    void CreatePipeline(GpuProfiler* profiler, CommandRecorder* recorder);
+private:
+    Context*                                                m_Context;
+    VkExtent2D                                              m_ScreenSize;
+    std::array<FrameResources, Swapchain::FRAMES_IN_FLIGHT> m_Frames;
+    std::unique_ptr<ComputePipeline>                        m_Pipeline;
+    BarrierBatch                                            m_BarrierBatch;
+};
@@ -0,0 +1,84 @@
+#include "Core/CnPch.hpp"
+#include "LightVolumeMesh.hpp"
+
+#include "Context.hpp"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+
+LightVolumeMesh::LightVolumeMesh(Context* context)
+    :   m_Context{context}, m_VertexCount{0}
+{
+    CreateVertexBuffer();
+}
+
+void LightVolumeMesh::CreateVertexBuffer()
+{
+    const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+    std::array<glm::vec3, 12> corners =
+            {
+                glm::vec3(-1.0f, t, 0.0f), glm::vec3(1.0f, t, 0.0f), glm::vec3(-1.0f, -t, 0.0f), glm::vec3(1.0f, -t, 0.0f),
+                glm::vec3(0.0f, -1.0f, t), glm::vec3(0.0f, 1.0f, t), glm::vec3(0.0f, -1.0f, -t), glm::vec3(0.0f, 1.0f, -t),
+                glm::vec3(t, 0.0f, -1.0f), glm::vec3(t, 0.0f, 1.0f), glm::vec3(-t, 0.0f, -1.0f), glm::vec3(-t, 0.0f, 1.0f)
+            };
+    std::array<uint32_t, 60> faces =
+            {
+                0, 11, 5,   0, 5, 1,    0, 1, 7,    0, 7, 10,   0, 10, 11,
+                1, 5, 9,    5, 11, 4,   11, 10, 2,  10, 7, 6,   7, 1, 8,
+                3, 9, 4,    3, 4, 2,    3, 2, 6,    3, 6, 8,    3, 8, 9,
+                4, 9, 5,    2, 4, 11,   6, 2, 10,   8, 6, 7,    9, 8, 1
+            };
+
+    // Every face splits into four through its edge midpoints, pushed out onto the sphere
+    std::vector<glm::vec3> vertices;
+    for(size_t i = 0; i < faces.size(); i += 3)
+    {
+        glm::vec3 a     = glm::normalize(corners[faces[i]]);
+        glm::vec3 b     = glm::normalize(corners[faces[i + 1]]);
+        glm::vec3 c     = glm::normalize(corners[faces[i + 2]]);
+        glm::vec3 ab    = glm::normalize(a + b);
+        glm::vec3 bc    = glm::normalize(b + c);
+        glm::vec3 ca    = glm::normalize(c + a);
+        vertices.insert(vertices.end(), { a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca });
+    }
+
+    // The vertices lie on the sphere, so the faces cut into it. Scaled by the closest face plane they enclose it
+    float closestFace = 1.0f;
+    for(size_t i = 0; i < vertices.size(); i += 3)
+    {
+        glm::vec3 normal = glm::normalize(glm::cross(vertices[i + 1] - vertices[i], vertices[i + 2] - vertices[i]));
+        closestFace = std::min(closestFace, glm::dot(normal, vertices[i]));
+    }
+
+    // std430 arrays of vec3 are padded to vec4
+    std::vector<glm::vec4> paddedVertices;
+    for(const glm::vec3& vertex : vertices)
+    {
+        paddedVertices.emplace_back(vertex / closestFace, 1.0f);
+    }
+    m_VertexCount = static_cast<uint32_t>(paddedVertices.size());
+
+    Buffer::BufferInfo vertexInfo{};
+    vertexInfo.size             = paddedVertices.size() * sizeof(glm::vec4);
+    vertexInfo.usageFlags       = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    vertexInfo.vmaMemoryUsage   = VMA_MEMORY_USAGE_AUTO;
+    vertexInfo.vmaAllocFlags    = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    m_VertexBuffer = std::make_unique<Buffer>(m_Context, vertexInfo);
+    m_VertexBuffer->Map(paddedVertices.data(), paddedVertices.size() * sizeof(glm::vec4));
+
+    VkDescriptorBufferInfo vertexBufferInfo{};
+    vertexBufferInfo.buffer = m_VertexBuffer->GetBuffer();
+    vertexBufferInfo.offset = 0;
+    vertexBufferInfo.range  = VK_WHOLE_SIZE;
+
+    DescriptorSet::BindingInfo vertexBinding{};
+    vertexBinding.type          = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    vertexBinding.binding       = 0;
+    vertexBinding.stageFlags    = VK_SHADER_STAGE_VERTEX_BIT;
+    vertexBinding.bufferInfo    = &vertexBufferInfo;
+
+    std::vector<DescriptorSet::BindingInfo> bindings = { vertexBinding };
+    m_DescriptorSet = std::make_unique<DescriptorSet>(m_Context, bindings);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "DescriptorSet.hpp"
+#include "Buffer/Buffer.hpp"
+
+class Context;
+
+// Unit sphere the point light volumes are drawn with: an icosahedron subdivided once, scaled so its faces enclose
+// the sphere. A plain triangle list with outward facing counter clockwise triangles, LightVolume.vert reads it
+// through gl_VertexIndex and places one instance per light.
+class LightVolumeMesh
+{
+public:
+    explicit LightVolumeMesh(Context* context);
+    ~LightVolumeMesh() = default;
+
+    LightVolumeMesh(const LightVolumeMesh& otherMesh) = delete;
+    LightVolumeMesh& operator=(const LightVolumeMesh& otherMesh) = delete;
+public:
+    inline uint32_t GetVertexCount() const { return m_VertexCount; }
+    inline VkDescriptorSet GetDescriptorSet() const { return m_DescriptorSet->GetDescriptorSet(); }
+    inline VkDescriptorSetLayout GetDescriptorSetLayout() const { return m_DescriptorSet->GetDescriptorSetLayout(); }
+private:
+    void CreateVertexBuffer();
+private:
+    Context*                        m_Context;
+    std::unique_ptr<Buffer>         m_VertexBuffer;
+    std::unique_ptr<DescriptorSet>  m_DescriptorSet;
+    uint32_t                        m_VertexCount;
+};
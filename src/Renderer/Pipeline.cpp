@@ -1,17 +1,27 @@
 #include "Core/CnPch.hpp"
 #include "Pipeline.hpp"
 
+#include "GpuProfiler.hpp"
+#include "CommandRecorder.hpp"
 #include "Buffer/Vertex.hpp"
 
 Pipeline::Pipeline(Context* context, const PipelineInfo& info)
     :   m_Context(context), m_Pipeline{}, m_PipelineLayout{}, m_CurrentCommandBuffer{},
-        m_DepthEnabled{info.depthFormat != VK_FORMAT_UNDEFINED}
+        m_DepthEnabled{info.depthFormat != VK_FORMAT_UNDEFINED}, m_ColorFormats{info.colorFormats}, m_DepthFormat{info.depthFormat}, m_Name{info.name}, m_Profiler{info.profiler}, m_Recorder{info.recorder}
 {
-    auto vertexCode     = ReadShaderCode(info.vertexPath);
-    auto fragmentCode   = ReadShaderCode(info.fragmentPath);
+    CN_PROFILE_ZONE_DETAIL("CreatePipeline", info.name);
 
-    VkShaderModule vertexModule     = CreateShaderModule(vertexCode);
-    VkShaderModule fragmentModule   = CreateShaderModule(fragmentCode);
+    // Depth only pipelines leave out the fragment stage
+    bool hasFragment = !info.fragmentPath.empty();
+
+    auto vertexCode = Utilities::ReadShaderCode(info.vertexPath);
+    VkShaderModule vertexModule     = Utilities::CreateShaderModule(m_Context->GetLogicalDevice(), vertexCode);
+    VkShaderModule fragmentModule   = VK_NULL_HANDLE;
+    if(hasFragment)
+    {
+        auto fragmentCode = Utilities::ReadShaderCode(info.fragmentPath);
+        fragmentModule = Utilities::CreateShaderModule(m_Context->GetLogicalDevice(), fragmentCode);
+    }
 
     VkPipelineShaderStageCreateInfo vertexShaderStageInfo{};
     vertexShaderStageInfo.sType     = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -26,6 +36,7 @@ Pipeline::Pipeline(Context* context, const PipelineInfo& info)
     fragmentShaderStageInfo.pName   = "main";
 
     std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages = { vertexShaderStageInfo, fragmentShaderStageInfo };
+    uint32_t stageCount = hasFragment ? 2U : 1U;
 
     auto vertexBindingDesc  = Vertex::GetBindingDescription();
     auto vertexAttribDesc   = Vertex::GetAttributeDescriptions();
@@ -84,7 +95,7 @@ Pipeline::Pipeline(Context* context, const PipelineInfo& info)
     depthStencilInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
     depthStencilInfo.depthTestEnable        = info.depthTest;
     depthStencilInfo.depthWriteEnable       = info.depthWrite;
-    depthStencilInfo.depthCompareOp         = VK_COMPARE_OP_LESS;
+    depthStencilInfo.depthCompareOp         = info.depthCompareOp;
     depthStencilInfo.depthBoundsTestEnable  = VK_FALSE;
     depthStencilInfo.minDepthBounds         = 0.0f; // Optional
     depthStencilInfo.maxDepthBounds         = 1.0f; // Optional
@@ -95,11 +106,11 @@ Pipeline::Pipeline(Context* context, const PipelineInfo& info)
     VkPipelineColorBlendAttachmentState colorBlendAttachment{};
     colorBlendAttachment.colorWriteMask         = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
     colorBlendAttachment.blendEnable            = info.enableBlend;
-    colorBlendAttachment.srcColorBlendFactor    = VK_BLEND_FACTOR_SRC_ALPHA;
-    colorBlendAttachment.dstColorBlendFactor    = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.srcColorBlendFactor    = info.additiveBlend ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_SRC_ALPHA;
+    colorBlendAttachment.dstColorBlendFactor    = info.additiveBlend ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
     colorBlendAttachment.colorBlendOp           = VK_BLEND_OP_ADD;
     colorBlendAttachment.srcAlphaBlendFactor    = VK_BLEND_FACTOR_ONE;
-    colorBlendAttachment.dstAlphaBlendFactor    = VK_BLEND_FACTOR_ZERO;
+    colorBlendAttachment.dstAlphaBlendFactor    = info.additiveBlend ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ZERO;
     colorBlendAttachment.alphaBlendOp           = VK_BLEND_OP_ADD;
 
     std::vector<VkPipelineColorBlendAttachmentState> colorBlendAttachments;
@@ -143,7 +154,7 @@ Pipeline::Pipeline(Context* context, const PipelineInfo& info)
     VkGraphicsPipelineCreateInfo pipelineInfo{};
     pipelineInfo.sType                  = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     pipelineInfo.pNext                  = &pipelineRenderingInfo;
-    pipelineInfo.stageCount             = static_cast<uint32_t>(shaderStages.size());
+    pipelineInfo.stageCount             = stageCount;
     pipelineInfo.pStages                = shaderStages.data();
     pipelineInfo.pVertexInputState      = &vertexInputInfo;
     pipelineInfo.pInputAssemblyState    = &inputAssemblyInfo;
@@ -160,13 +171,22 @@ Pipeline::Pipeline(Context* context, const PipelineInfo& info)
     VK_CHECK(vkCreateGraphicsPipelines(m_Context->GetLogicalDevice(), VK_NULL_HANDLE, 1U, &pipelineInfo, nullptr, &m_Pipeline))
 
     vkDestroyShaderModule(m_Context->GetLogicalDevice(), vertexModule, nullptr);
-    vkDestroyShaderModule(m_Context->GetLogicalDevice(), fragmentModule, nullptr);
+    if(fragmentModule)
+    {
+        vkDestroyShaderModule(m_Context->GetLogicalDevice(), fragmentModule, nullptr);
+    }
 }
 
-void Pipeline::BeginRender(VkCommandBuffer commandBuffer, const RenderInfo& renderInfo)
+void Pipeline::BeginRender(VkCommandBuffer commandBuffer, const RenderInfo& renderInfo, std::string_view scopeName, bool secondaryContents)
 {
+    if(m_Recorder->GetCommandBuffer() != commandBuffer)
+    {
+        throw std::runtime_error("Error: Pipeline " + m_Name + " records into a command buffer its recorder was not begun on.");
+    }
+
     m_CurrentCommandBuffer = commandBuffer;
-    std::vector<VkRenderingAttachmentInfo> renderAttachments;
+    std::pmr::vector<VkRenderingAttachmentInfo> renderAttachments(renderInfo.colorAttachments.get_allocator());
+    renderAttachments.reserve(renderInfo.colorAttachments.size());
 
     for(size_t i = 0; i < renderInfo.colorAttachments.size(); i++)
     {
@@ -194,8 +214,14 @@ void Pipeline::BeginRender(VkCommandBuffer commandBuffer, const RenderInfo& rend
         depthRenderingAttachmentInfo.clearValue     = renderInfo.depthAttachment.clearValue;
     }
 
+    if(m_Profiler)
+    {
+        m_Profiler->BeginScope(m_CurrentCommandBuffer, scopeName.empty() ? m_Name : scopeName);
+    }
+
     VkRenderingInfo dynRenderingInfo{};
     dynRenderingInfo.sType                  = VK_STRUCTURE_TYPE_RENDERING_INFO;
+    dynRenderingInfo.flags                  = secondaryContents ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0U;
     dynRenderingInfo.renderArea             = {{0U, 0U}, renderInfo.extent};
     dynRenderingInfo.layerCount             = 1U;
     dynRenderingInfo.colorAttachmentCount   = static_cast<uint32_t>(renderAttachments.size());
@@ -204,89 +230,132 @@ void Pipeline::BeginRender(VkCommandBuffer commandBuffer, const RenderInfo& rend
 
     vkCmdBeginRenderingKHR(m_CurrentCommandBuffer, &dynRenderingInfo);
 
+    // Only vkCmdExecuteCommands is allowed inside a render pass with secondary contents
+    if(secondaryContents)
+    {
+        return;
+    }
+
+    m_Recorder->BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, m_Pipeline);
+    SetViewportAndScissor(*m_Recorder, renderInfo.extent);
+}
+
+void Pipeline::ExecuteSecondaries(std::span<const VkCommandBuffer> commandBuffers)
+{
+    if(commandBuffers.empty())
+    {
+        return;
+    }
+
+    vkCmdExecuteCommands(m_CurrentCommandBuffer, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+    // Whatever the secondaries bound is undefined on the primary afterwards
+    m_Recorder->Invalidate();
+}
+
+void Pipeline::BeginSecondary(CommandRecorder& recorder, VkCommandBuffer commandBuffer, VkExtent2D extent) const
+{
+    VkCommandBufferInheritanceRenderingInfo inheritanceRenderingInfo{};
+    inheritanceRenderingInfo.sType                      = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+    inheritanceRenderingInfo.colorAttachmentCount       = static_cast<uint32_t>(m_ColorFormats.size());
+    inheritanceRenderingInfo.pColorAttachmentFormats    = m_ColorFormats.data();
+    inheritanceRenderingInfo.depthAttachmentFormat      = m_DepthFormat;
+    inheritanceRenderingInfo.rasterizationSamples       = VK_SAMPLE_COUNT_1_BIT;
+
+    VkCommandBufferInheritanceInfo inheritanceInfo{};
+    inheritanceInfo.sType   = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext   = &inheritanceRenderingInfo;
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo  = &inheritanceInfo;
+
+    VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo))
+
+    // Secondaries inherit no state from the primary, everything is bound again
+    recorder.Begin(commandBuffer);
+    recorder.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, m_Pipeline);
+    SetViewportAndScissor(recorder, extent);
+}
+
+void Pipeline::EndSecondary(CommandRecorder& recorder) const
+{
+    VK_CHECK(vkEndCommandBuffer(recorder.GetCommandBuffer()))
+}
+
+void Pipeline::SetViewportAndScissor(CommandRecorder& recorder, VkExtent2D extent) const
+{
     VkViewport viewport{};
-    viewport.width      = static_cast<float>(renderInfo.extent.width);
-    viewport.height     = static_cast<float>(renderInfo.extent.height);
+    viewport.width      = static_cast<float>(extent.width);
+    viewport.height     = static_cast<float>(extent.height);
     viewport.maxDepth   = 1.0f;
 
     VkRect2D scissor{};
-    scissor.extent = renderInfo.extent;
-
-    vkCmdBindPipeline(m_CurrentCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_Pipeline);
+    scissor.extent = extent;
 
-    vkCmdSetViewport(m_CurrentCommandBuffer, 0U, 1U, &viewport);
-    vkCmdSetScissor(m_CurrentCommandBuffer, 0U, 1U, &scissor);
+    recorder.SetViewport(viewport);
+    recorder.SetScissor(scissor);
 }
 
 void Pipeline::EndRender()
 {
     vkCmdEndRenderingKHR(m_CurrentCommandBuffer);
+
+    if(m_Profiler)
+    {
+        m_Profiler->EndScope(m_CurrentCommandBuffer);
+    }
     m_CurrentCommandBuffer = VK_NULL_HANDLE;
 }
 
-void Pipeline::Draw(uint32_t vertexCount)
+void Pipeline::Draw(uint32_t vertexCount, uint32_t instanceCount)
 {
-    vkCmdDraw(m_CurrentCommandBuffer, vertexCount, 1, 0, 0);
+    vkCmdDraw(m_CurrentCommandBuffer, vertexCount, instanceCount, 0, 0);
 }
 
-void Pipeline::DrawIndexed(const uint32_t indexCount)
+void Pipeline::DrawIndexed(const uint32_t indexCount, const uint32_t firstIndex, const int32_t vertexOffset, const uint32_t firstInstance)
 {
-    vkCmdDrawIndexed(m_CurrentCommandBuffer, indexCount, 1, 0, 0, 0);
+    vkCmdDrawIndexed(m_CurrentCommandBuffer, indexCount, 1, firstIndex, vertexOffset, firstInstance);
 }
 
-void Pipeline::BindVertexBuffer(const VertexBuffer& vb)
+void Pipeline::DrawIndexed(CommandRecorder& recorder, const uint32_t indexCount, const uint32_t firstIndex, const int32_t vertexOffset, const uint32_t firstInstance) const
 {
-    vb.Bind(m_CurrentCommandBuffer);
+    vkCmdDrawIndexed(recorder.GetCommandBuffer(), indexCount, 1, firstIndex, vertexOffset, firstInstance);
 }
 
-void Pipeline::BindIndexBuffer(const IndexBuffer& ib)
+void Pipeline::DrawIndexedIndirect(VkBuffer buffer, const VkDeviceSize offset, const uint32_t drawCount)
 {
-    ib.Bind(m_CurrentCommandBuffer);
+    vkCmdDrawIndexedIndirect(m_CurrentCommandBuffer, buffer, offset, drawCount, sizeof(VkDrawIndexedIndirectCommand));
 }
 
-void Pipeline::BindDescriptorSet(VkDescriptorSet descriptorSet, const uint32_t index)
+void Pipeline::DrawIndexedIndirectCount(VkBuffer buffer, const VkDeviceSize offset, VkBuffer countBuffer, const VkDeviceSize countOffset, const uint32_t maxDrawCount)
 {
-    vkCmdBindDescriptorSets(m_CurrentCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout, index, 1U, &descriptorSet, 0U, nullptr);
+    vkCmdDrawIndexedIndirectCountKHR(m_CurrentCommandBuffer, buffer, offset, countBuffer, countOffset, maxDrawCount, sizeof(VkDrawIndexedIndirectCommand));
 }
 
-void Pipeline::PushConstant(VkShaderStageFlags shaderStageFlags, uint32_t offset, uint32_t size, const void* data)
+void Pipeline::BindGeometry(const GeometryArena& geometryArena, const uint32_t block)
 {
-    vkCmdPushConstants(m_CurrentCommandBuffer, m_PipelineLayout, shaderStageFlags, offset, size, data);
+    BindGeometry(*m_Recorder, geometryArena, block);
 }
 
-std::vector<char> Pipeline::ReadShaderCode(std::string_view path)
+void Pipeline::BindGeometry(CommandRecorder& recorder, const GeometryArena& geometryArena, const uint32_t block) const
 {
-    std::filesystem::path cwd = std::filesystem::current_path().parent_path();
-    std::string fullPath = cwd.string() + std::string(path);
-    std::ifstream shaderFile(fullPath, std::ios::ate | std::ios::binary);
-
-    if(!shaderFile.is_open())
-    {
-        throw std::runtime_error("Error: Failed to open file " + fullPath);
-    }
-
-    std::streamsize fileSize = static_cast<std::streamsize>(shaderFile.tellg());
-    std::vector<char> buffer(fileSize);
-
-    shaderFile.seekg(0);
-    shaderFile.read(buffer.data(), fileSize);
-    shaderFile.close();
-
-    return buffer;
+    geometryArena.Bind(recorder, block);
 }
 
-VkShaderModule Pipeline::CreateShaderModule(std::span<char> shaderCode)
+void Pipeline::BindDescriptorSet(VkDescriptorSet descriptorSet, const uint32_t index)
 {
-    VkShaderModuleCreateInfo moduleCreateInfo{};
-    moduleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    moduleCreateInfo.codeSize = shaderCode.size();
-    moduleCreateInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
-
-    VkShaderModule shaderModule;
+    BindDescriptorSet(*m_Recorder, descriptorSet, index);
+}
 
-    VK_CHECK(vkCreateShaderModule(m_Context->GetLogicalDevice(), &moduleCreateInfo, nullptr, &shaderModule))
+void Pipeline::BindDescriptorSet(CommandRecorder& recorder, VkDescriptorSet descriptorSet, const uint32_t index) const
+{
+    recorder.BindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout, index, descriptorSet);
+}
 
-    return shaderModule;
+void Pipeline::PushConstant(VkShaderStageFlags shaderStageFlags, uint32_t offset, uint32_t size, const void* data)
+{
+    m_Recorder->PushConstants(m_PipelineLayout, shaderStageFlags, offset, size, data);
 }
 
 Pipeline::~Pipeline()
@@ -2,8 +2,10 @@
 
 #include "Context.hpp"
 
-#include "Buffer/VertexBuffer.hpp"
-#include "Buffer/IndexBuffer.hpp"
+#include "Buffer/GeometryArena.hpp"
+
+class GpuProfiler;
+class CommandRecorder;
 
 class Pipeline
 {
@@ -11,6 +13,7 @@ public:
     struct PipelineInfo
     {
         std::string_view        vertexPath;
+        // Empty for depth only pipelines
         std::string_view        fragmentPath;
         std::vector<VkFormat>   colorFormats;
         VkFormat                depthFormat;
@@ -20,9 +23,18 @@ public:
         VkBool32                depthWrite;
         VkBool32                vertexBindings;
         VkBool32                enableBlend;
+        // With enableBlend, adds the output onto the attachment instead of blending by its alpha
+        VkBool32                additiveBlend{VK_FALSE};
+        VkCompareOp             depthCompareOp{VK_COMPARE_OP_LESS};
 
         std::vector<VkDescriptorSetLayout>  layouts;
         std::vector<VkPushConstantRange>    pushConstants;
+
+        // Optional, BeginRender/EndRender are timed as a scope with this name
+        std::string_view    name;
+        GpuProfiler*        profiler;
+        // Required, binds and pushes go through it so redundant ones are skipped
+        CommandRecorder*    recorder;
     };
     struct Attachment
     {
@@ -32,11 +44,12 @@ public:
         VkAttachmentStoreOp storeOp{};
         VkClearValue        clearValue{};
     };
+    // Built once per pass and frame, so the attachments live in the frame's arena
     struct RenderInfo
     {
-        std::vector<Attachment>     colorAttachments;
-        Attachment                  depthAttachment;
-        VkExtent2D                  extent;
+        std::pmr::vector<Attachment>    colorAttachments;
+        Attachment                      depthAttachment;
+        VkExtent2D                      extent;
     };
 public:
     Pipeline(Context* context, const PipelineInfo& info);
@@ -45,21 +58,39 @@ public:
     Pipeline(const Pipeline& otherPipeline) = delete;
     Pipeline& operator=(const Pipeline& otherPipeline) = delete;
 public:
-    void BeginRender(VkCommandBuffer commandBuffer, const RenderInfo& renderInfo);
+    // scopeName overrides the profiler scope of pipelines recorded by more than one pass.
+    // With secondaryContents the render pass is filled by ExecuteSecondaries only, nothing is bound on the primary
+    void BeginRender(VkCommandBuffer commandBuffer, const RenderInfo& renderInfo, std::string_view scopeName = {}, bool secondaryContents = false);
     void EndRender();
-    void Draw(uint32_t vertexCount);
-    void DrawIndexed(uint32_t indexCount);
-    void BindVertexBuffer(const VertexBuffer& vb);
-    void BindIndexBuffer(const IndexBuffer& ib);
+    void ExecuteSecondaries(std::span<const VkCommandBuffer> commandBuffers);
+    void Draw(uint32_t vertexCount, uint32_t instanceCount = 1);
+    void DrawIndexed(uint32_t indexCount, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0);
+    void DrawIndexedIndirect(VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount);
+    // The draw count is read from countBuffer on the GPU, clamped to maxDrawCount
+    void DrawIndexedIndirectCount(VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countOffset, uint32_t maxDrawCount);
+    void BindGeometry(const GeometryArena& geometryArena, uint32_t block);
     void BindDescriptorSet(VkDescriptorSet descriptorSet, uint32_t index);
     void PushConstant(VkShaderStageFlags shaderStageFlags, uint32_t offset, uint32_t size, const void* data);
+public:
+    // Secondary command buffers continuing a secondaryContents BeginRender, each recorded through its own recorder.
+    // These only read the pipeline, so several threads can record with them at once
+    void BeginSecondary(CommandRecorder& recorder, VkCommandBuffer commandBuffer, VkExtent2D extent) const;
+    void EndSecondary(CommandRecorder& recorder) const;
+    void DrawIndexed(CommandRecorder& recorder, uint32_t indexCount, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) const;
+    void BindGeometry(CommandRecorder& recorder, const GeometryArena& geometryArena, uint32_t block) const;
+    void BindDescriptorSet(CommandRecorder& recorder, VkDescriptorSet descriptorSet, uint32_t index) const;
 private:
-    std::vector<char> ReadShaderCode(std::string_view path);
-    VkShaderModule CreateShaderModule(std::span<char> shaderCode);
+    void SetViewportAndScissor(CommandRecorder& recorder, VkExtent2D extent) const;
 private:
     Context*            m_Context;
     VkPipeline          m_Pipeline;
     VkPipelineLayout    m_PipelineLayout;
     VkCommandBuffer     m_CurrentCommandBuffer;
     VkBool32            m_DepthEnabled;
+    // Inherited by secondary command buffers, they have to match the attachments of the render pass
+    std::vector<VkFormat>   m_ColorFormats;
+    VkFormat                m_DepthFormat;
+    std::string         m_Name;
+    GpuProfiler*        m_Profiler;
+    CommandRecorder*    m_Recorder;
 };
@@ -0,0 +1,469 @@
+#include "Core/CnPch.hpp"
+#include "RenderGraph.hpp"
+
+#include "Image.hpp"
+
+RenderGraph::RenderGraph(Context* context)
+{
+    for(std::unique_ptr<TransientImagePool>& pool : m_TransientPools)
+    {
+        pool = std::make_unique<TransientImagePool>(context);
+    }
+}
+
+RenderGraph::ResourceHandle RenderGraph::ImportImage(std::string_view name)
+{
+    if(m_Compiled)
+    {
+        throw std::runtime_error("Error: Render graph resources have to be declared before compiling.");
+    }
+
+    ResourceNode resource{};
+    resource.name = std::string(name);
+    m_Resources.push_back(resource);
+
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+RenderGraph::ResourceHandle RenderGraph::CreateImage(std::string_view name, const TransientImageInfo& imageInfo)
+{
+    ResourceHandle handle = ImportImage(name);
+    m_Resources[handle].transient       = true;
+    m_Resources[handle].transientInfo   = imageInfo;
+
+    return handle;
+}
+
+void RenderGraph::SetImportedImage(ResourceHandle resource, size_t frameIndex, Image* image)
+{
+    if(m_Resources.at(resource).transient)
+    {
+        throw std::runtime_error("Error: Render graph image " + m_Resources[resource].name + " is owned by the graph.");
+    }
+    m_Resources[resource].images.at(frameIndex) = image;
+}
+
+void RenderGraph::AddPass(PassInfo&& passInfo)
+{
+    if(m_Compiled)
+    {
+        throw std::runtime_error("Error: Render graph passes have to be declared before compiling.");
+    }
+    if(!passInfo.execute)
+    {
+        throw std::runtime_error("Error: Render graph pass " + passInfo.name + " has nothing to execute.");
+    }
+    for(const ResourceUsage& usage : passInfo.usages)
+    {
+        if(usage.resource >= m_Resources.size() || usage.access == Access::None)
+        {
+            throw std::runtime_error("Error: Render graph pass " + passInfo.name + " uses an invalid resource.");
+        }
+    }
+
+    PassNode pass{};
+    pass.info = std::move(passInfo);
+    m_Passes.push_back(std::move(pass));
+}
+
+void RenderGraph::MarkOutput(ResourceHandle resource, Access finalAccess)
+{
+    ResourceNode& node  = m_Resources.at(resource);
+    node.output         = true;
+    node.finalAccess    = finalAccess;
+}
+
+void RenderGraph::Compile()
+{
+    CullPasses();
+    ResolveStoreOps();
+    AllocateTransientImages();
+
+    m_Schedule.clear();
+    std::string order;
+    uint32_t culledCount = 0;
+    for(const PassNode& pass : m_Passes)
+    {
+        m_Schedule.push_back({ pass.info.name, pass.culled, 0 });
+
+        if(pass.culled)
+        {
+            culledCount++;
+            continue;
+        }
+        order += order.empty() ? pass.info.name : " -> " + pass.info.name;
+    }
+    // Final transitions of the outputs, e.g. to present
+    m_Schedule.push_back({ "Outputs", false, 0 });
+
+    m_Compiled = true;
+    std::cout << "[Cone] Render graph: " << order << " (" << culledCount << " culled)" << std::endl;
+}
+
+void RenderGraph::Execute(VkCommandBuffer commandBuffer, size_t frameIndex, std::pmr::memory_resource* frameArena)
+{
+    if(!m_Compiled)
+    {
+        throw std::runtime_error("Error: Render graph has to be compiled before executing.");
+    }
+
+    m_FrameBarrierCount = 0;
+    for(size_t i = 0; i < m_Passes.size(); i++)
+    {
+        const PassNode& pass = m_Passes[i];
+        if(pass.culled)
+        {
+            continue;
+        }
+
+        for(size_t j = 0; j < pass.info.usages.size(); j++)
+        {
+            const ResourceUsage& usage = pass.info.usages[j];
+            Image* image = m_Resources[usage.resource].images.at(frameIndex);
+            if(image == nullptr)
+            {
+                throw std::runtime_error("Error: Render graph resource " + m_Resources[usage.resource].name + " has no image bound.");
+            }
+
+            // Contents that get cleared or fully overwritten do not need their old layout preserved
+            if(pass.aliasAcquires[j])
+            {
+                image->AliasAfter(*m_Resources[m_Resources[usage.resource].aliasPredecessor].images[frameIndex]);
+            } else if(DiscardsContents(usage))
+            {
+                image->DiscardContents();
+            }
+
+            Utilities::ImageSyncState state = GetSyncState(usage.access);
+            image->ChangeLayout(m_BarrierBatch, state.layout, state.stageMask, state.accessMask);
+        }
+
+        m_Schedule[i].barrierCount = static_cast<uint32_t>(m_BarrierBatch.GetPendingCount());
+        m_FrameBarrierCount += m_Schedule[i].barrierCount;
+        m_BarrierBatch.Flush(commandBuffer);
+
+        pass.info.execute(commandBuffer, BuildRenderInfo(pass, frameIndex, frameArena));
+    }
+
+    for(const ResourceNode& resource : m_Resources)
+    {
+        Image* image = resource.images[frameIndex];
+        if(resource.output && resource.finalAccess != Access::None && image != nullptr)
+        {
+            Utilities::ImageSyncState state = GetSyncState(resource.finalAccess);
+            image->ChangeLayout(m_BarrierBatch, state.layout, state.stageMask, state.accessMask);
+        }
+    }
+
+    m_Schedule.back().barrierCount = static_cast<uint32_t>(m_BarrierBatch.GetPendingCount());
+    m_FrameBarrierCount += m_Schedule.back().barrierCount;
+    m_BarrierBatch.Flush(commandBuffer);
+}
+
+Utilities::ImageSyncState RenderGraph::GetSyncState(Access access)
+{
+    switch(access)
+    {
+        case Access::ColorAttachmentWrite:
+            return Utilities::GetImageSyncState(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+        case Access::DepthAttachmentWrite:
+            return Utilities::GetImageSyncState(VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL);
+        case Access::DepthAttachmentRead:
+            // Read only depth may be sampled by the fragment shaders of the same pass
+            return { VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_OPTIMAL,
+                     VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                     VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_SHADER_SAMPLED_READ_BIT };
+        case Access::FragmentSampledRead:
+            return Utilities::GetImageSyncState(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        case Access::ComputeSampledRead:
+            return { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT };
+        case Access::ComputeStorageRead:
+            return { VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT };
+        case Access::ComputeStorageWrite:
+            return Utilities::GetImageSyncState(VK_IMAGE_LAYOUT_GENERAL);
+        case Access::TransferRead:
+            return Utilities::GetImageSyncState(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        case Access::TransferWrite:
+            return Utilities::GetImageSyncState(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        case Access::Present:
+            return Utilities::GetImageSyncState(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+        case Access::None:
+            break;
+    }
+
+    throw std::invalid_argument("Error: Render graph access has no synchronization scope.");
+}
+
+bool RenderGraph::IsAttachment(Access access)
+{
+    return access == Access::ColorAttachmentWrite || access == Access::DepthAttachmentWrite || access == Access::DepthAttachmentRead;
+}
+
+bool RenderGraph::IsWrite(Access access)
+{
+    return access == Access::ColorAttachmentWrite || access == Access::DepthAttachmentWrite ||
+           access == Access::ComputeStorageWrite || access == Access::TransferWrite;
+}
+
+bool RenderGraph::ReadsContents(const ResourceUsage& usage)
+{
+    // Storage and transfer writes may touch only part of the image, so what was there before has to survive
+    return !DiscardsContents(usage);
+}
+
+bool RenderGraph::DiscardsContents(const ResourceUsage& usage)
+{
+    bool attachmentWrite = usage.access == Access::ColorAttachmentWrite || usage.access == Access::DepthAttachmentWrite;
+    return attachmentWrite && usage.loadOp != VK_ATTACHMENT_LOAD_OP_LOAD;
+}
+
+VkImageUsageFlags RenderGraph::GetUsageFlags(Access access)
+{
+    switch(access)
+    {
+        case Access::ColorAttachmentWrite:
+            return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        case Access::DepthAttachmentWrite:
+        case Access::DepthAttachmentRead:
+            return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        case Access::FragmentSampledRead:
+        case Access::ComputeSampledRead:
+            return VK_IMAGE_USAGE_SAMPLED_BIT;
+        case Access::ComputeStorageRead:
+        case Access::ComputeStorageWrite:
+            return VK_IMAGE_USAGE_STORAGE_BIT;
+        case Access::TransferRead:
+            return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        case Access::TransferWrite:
+            return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        case Access::Present:
+        case Access::None:
+            break;
+    }
+
+    return 0;
+}
+
+void RenderGraph::CullPasses()
+{
+    // Walk backwards from the outputs, a pass survives only if a later consumer needs one of its writes
+    std::vector<bool> needed(m_Resources.size(), false);
+    for(size_t i = 0; i < m_Resources.size(); i++)
+    {
+        needed[i] = m_Resources[i].output;
+    }
+
+    for(auto pass = m_Passes.rbegin(); pass != m_Passes.rend(); ++pass)
+    {
+        bool live = pass->info.sideEffects;
+        for(const ResourceUsage& usage : pass->info.usages)
+        {
+            live |= IsWrite(usage.access) && needed[usage.resource];
+        }
+
+        pass->culled = !live;
+        if(!live)
+        {
+            continue;
+        }
+
+        for(const ResourceUsage& usage : pass->info.usages)
+        {
+            if(DiscardsContents(usage))
+            {
+                needed[usage.resource] = false;
+            }
+        }
+        for(const ResourceUsage& usage : pass->info.usages)
+        {
+            if(ReadsContents(usage))
+            {
+                needed[usage.resource] = true;
+            }
+        }
+    }
+}
+
+void RenderGraph::ResolveStoreOps()
+{
+    // Attachments nobody reads afterwards are not written back to memory
+    for(size_t i = 0; i < m_Passes.size(); i++)
+    {
+        PassNode& pass = m_Passes[i];
+        pass.storeOps.assign(pass.info.usages.size(), VK_ATTACHMENT_STORE_OP_STORE);
+        if(pass.culled)
+        {
+            continue;
+        }
+
+        for(size_t j = 0; j < pass.info.usages.size(); j++)
+        {
+            const ResourceUsage& usage = pass.info.usages[j];
+            if(!IsWrite(usage.access) || !IsAttachment(usage.access))
+            {
+                continue;
+            }
+
+            std::optional<bool> readLater;
+            for(size_t k = i + 1; k < m_Passes.size() && !readLater.has_value(); k++)
+            {
+                if(m_Passes[k].culled)
+                {
+                    continue;
+                }
+                for(const ResourceUsage& laterUsage : m_Passes[k].info.usages)
+                {
+                    if(laterUsage.resource == usage.resource)
+                    {
+                        readLater = ReadsContents(laterUsage);
+                        break;
+                    }
+                }
+            }
+
+            bool keep = readLater.value_or(m_Resources[usage.resource].output);
+            pass.storeOps[j] = keep ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        }
+    }
+}
+
+void RenderGraph::AllocateTransientImages()
+{
+    std::vector<VkImageUsageFlags> usageFlags(m_Resources.size(), 0);
+    for(PassNode& pass : m_Passes)
+    {
+        pass.aliasAcquires.assign(pass.info.usages.size(), false);
+    }
+
+    for(uint32_t i = 0; i < m_Passes.size(); i++)
+    {
+        if(m_Passes[i].culled)
+        {
+            continue;
+        }
+
+        for(const ResourceUsage& usage : m_Passes[i].info.usages)
+        {
+            ResourceNode& resource = m_Resources[usage.resource];
+            // Nothing is carried over between frames, so the first use has to produce the contents
+            if(resource.transient && !resource.firstPass.has_value() && !IsWrite(usage.access))
+            {
+                throw std::runtime_error("Error: Transient image " + resource.name + " is read before it is written.");
+            }
+
+            resource.firstPass  = resource.firstPass.value_or(i);
+            resource.lastPass   = i;
+            usageFlags[usage.resource] |= GetUsageFlags(usage.access);
+        }
+    }
+
+    // Transient images used by culled passes only are never allocated
+    std::vector<ResourceHandle> transients;
+    std::vector<TransientImagePool::ImageRequest> requests;
+    for(ResourceHandle i = 0; i < m_Resources.size(); i++)
+    {
+        const ResourceNode& resource = m_Resources[i];
+        if(!resource.transient || !resource.firstPass.has_value())
+        {
+            continue;
+        }
+
+        TransientImagePool::ImageRequest request{};
+        request.imageInfo.format        = resource.transientInfo.format;
+        request.imageInfo.desiredLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        request.imageInfo.dimension     = resource.transientInfo.dimension;
+        request.imageInfo.usageFlags    = usageFlags[i];
+        request.imageInfo.aspectFlags   = resource.transientInfo.aspectFlags;
+        request.imageInfo.genMipmaps    = VK_FALSE;
+        request.firstPass               = resource.firstPass.value();
+        request.lastPass                = resource.lastPass;
+
+        transients.push_back(i);
+        requests.push_back(request);
+    }
+
+    if(requests.empty())
+    {
+        return;
+    }
+
+    // Every frame in flight gets the same layout, so the alias predecessors are shared
+    VkDeviceSize allocatedSize  = 0;
+    VkDeviceSize lazySize       = 0;
+    for(std::unique_ptr<TransientImagePool>& pool : m_TransientPools)
+    {
+        pool->Allocate(requests);
+        allocatedSize   += pool->GetAllocatedSize();
+        lazySize        += pool->GetLazySize();
+    }
+
+    // Before, every frame in flight had its own dedicated allocation per image
+    const VkDeviceSize previousSize = m_TransientPools[0]->GetRequestedSize() * Swapchain::FRAMES_IN_FLIGHT;
+    const double mebibyte = 1024.0 * 1024.0;
+    std::cout << "[Cone] Transient images: " << requests.size() << " images in " << m_TransientPools[0]->GetBlockCount() << " allocations per frame in flight, "
+              << static_cast<double>(allocatedSize) / mebibyte << " MB (" << static_cast<double>(lazySize) / mebibyte << " MB lazily allocated), "
+              << "saved " << (static_cast<double>(previousSize) - static_cast<double>(allocatedSize)) / mebibyte << " MB of "
+              << static_cast<double>(previousSize) / mebibyte << " MB" << std::endl;
+
+    for(size_t i = 0; i < transients.size(); i++)
+    {
+        ResourceNode& resource = m_Resources[transients[i]];
+        for(size_t frame = 0; frame < m_TransientPools.size(); frame++)
+        {
+            resource.images[frame] = m_TransientPools[frame]->GetImage(i);
+        }
+        resource.aliasPredecessor = transients[m_TransientPools[0]->GetAliasPredecessor(i)];
+
+        if(resource.aliasPredecessor == transients[i])
+        {
+            continue;
+        }
+
+        // The usage that starts the image's live range takes the memory over
+        std::vector<ResourceUsage>& usages = m_Passes[resource.firstPass.value()].info.usages;
+        for(size_t j = 0; j < usages.size(); j++)
+        {
+            if(usages[j].resource == transients[i])
+            {
+                m_Passes[resource.firstPass.value()].aliasAcquires[j] = true;
+                break;
+            }
+        }
+    }
+}
+
+Pipeline::RenderInfo RenderGraph::BuildRenderInfo(const PassNode& pass, size_t frameIndex, std::pmr::memory_resource* frameArena) const
+{
+    Pipeline::RenderInfo renderInfo{.colorAttachments = std::pmr::vector<Pipeline::Attachment>(frameArena), .depthAttachment = {}, .extent = {}};
+    renderInfo.colorAttachments.reserve(pass.info.usages.size());
+
+    for(size_t i = 0; i < pass.info.usages.size(); i++)
+    {
+        const ResourceUsage& usage = pass.info.usages[i];
+        if(!IsAttachment(usage.access))
+        {
+            continue;
+        }
+
+        const Image* image = m_Resources[usage.resource].images[frameIndex];
+
+        Pipeline::Attachment attachment{};
+        attachment.imageView    = image->GetImageView();
+        attachment.imageLayout  = image->GetImageLayout();
+        // Read only depth keeps what an earlier pass wrote
+        attachment.loadOp       = usage.access == Access::DepthAttachmentRead ? VK_ATTACHMENT_LOAD_OP_LOAD : usage.loadOp;
+        attachment.storeOp      = pass.storeOps[i];
+        attachment.clearValue   = usage.clearValue;
+
+        if(usage.access == Access::ColorAttachmentWrite)
+        {
+            renderInfo.colorAttachments.push_back(attachment);
+        } else
+        {
+            renderInfo.depthAttachment = attachment;
+        }
+        renderInfo.extent = image->GetDimension();
+    }
+
+    return renderInfo;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Pipeline.hpp"
+#include "BarrierBatch.hpp"
+#include "Swapchain.hpp"
+#include "TransientImagePool.hpp"
+
+class Context;
+class Image;
+
+class RenderGraph
+{
+public:
+    using ResourceHandle = uint32_t;
+
+    enum class Access
+    {
+        None,
+        ColorAttachmentWrite,
+        DepthAttachmentWrite,
+        DepthAttachmentRead,
+        FragmentSampledRead,
+        ComputeSampledRead,
+        ComputeStorageRead,
+        ComputeStorageWrite,
+        TransferRead,
+        TransferWrite,
+        Present
+    };
+    struct TransientImageInfo
+    {
+        VkFormat            format;
+        VkExtent2D          dimension;
+        VkImageAspectFlags  aspectFlags;
+    };
+    struct ResourceUsage
+    {
+        ResourceHandle      resource{};
+        Access              access{Access::None};
+        VkAttachmentLoadOp  loadOp{VK_ATTACHMENT_LOAD_OP_DONT_CARE};
+        VkClearValue        clearValue{};
+    };
+    struct PassInfo
+    {
+        std::string                 name;
+        std::vector<ResourceUsage>  usages;
+        // Keeps the pass even when nothing in the graph consumes its writes
+        bool                        sideEffects{false};
+
+        std::function<void(VkCommandBuffer, const Pipeline::RenderInfo&)> execute;
+    };
+    struct ScheduledPass
+    {
+        std::string_view    name;
+        bool                culled;
+        uint32_t            barrierCount;
+    };
+public:
+    explicit RenderGraph(Context* context);
+    ~RenderGraph() = default;
+
+    RenderGraph(const RenderGraph& otherGraph) = delete;
+    RenderGraph& operator=(const RenderGraph& otherGraph) = delete;
+public:
+    ResourceHandle ImportImage(std::string_view name);
+    // Owned by the graph, one image per frame in flight with its usage flags and memory derived from the passes
+    ResourceHandle CreateImage(std::string_view name, const TransientImageInfo& imageInfo);
+    void SetImportedImage(ResourceHandle resource, size_t frameIndex, Image* image);
+    void AddPass(PassInfo&& passInfo);
+    void MarkOutput(ResourceHandle resource, Access finalAccess = Access::None);
+    void Compile();
+    // Per frame data of the passes is allocated from frameArena
+    void Execute(VkCommandBuffer commandBuffer, size_t frameIndex, std::pmr::memory_resource* frameArena);
+public:
+    // Passes in submission order, barrier counts are from the last executed frame
+    inline const std::vector<ScheduledPass>& GetSchedule() const { return m_Schedule; }
+    inline uint32_t GetFrameBarrierCount() const { return m_FrameBarrierCount; }
+    inline Image* GetImage(ResourceHandle resource, size_t frameIndex) const { return m_Resources.at(resource).images.at(frameIndex); }
+private:
+    struct ResourceNode
+    {
+        std::string                                         name;
+        // Indexed by frame in flight
+        std::array<Image*, Swapchain::FRAMES_IN_FLIGHT>     images{};
+        bool                                                output{false};
+        Access                                              finalAccess{Access::None};
+        bool                                                transient{false};
+        TransientImageInfo                                  transientInfo{};
+        // Live range over the passes that survived culling
+        std::optional<uint32_t>                             firstPass;
+        uint32_t                                            lastPass{0};
+        ResourceHandle                                      aliasPredecessor{0};
+    };
+    struct PassNode
+    {
+        PassInfo                            info;
+        bool                                culled{false};
+        std::vector<VkAttachmentStoreOp>    storeOps;
+        // Set on the first use of a transient image whose memory was last used by another image
+        std::vector<bool>                   aliasAcquires;
+    };
+private:
+    static Utilities::ImageSyncState GetSyncState(Access access);
+    static bool IsAttachment(Access access);
+    static bool IsWrite(Access access);
+    static bool ReadsContents(const ResourceUsage& usage);
+    static bool DiscardsContents(const ResourceUsage& usage);
+    static VkImageUsageFlags GetUsageFlags(Access access);
+    void CullPasses();
+    void ResolveStoreOps();
+    void AllocateTransientImages();
+    Pipeline::RenderInfo BuildRenderInfo(const PassNode& pass, size_t frameIndex, std::pmr::memory_resource* frameArena) const;
+private:
+    // Memory is aliased between the passes of a frame, the frames in flight never share transient images
+    std::array<std::unique_ptr<TransientImagePool>, Swapchain::FRAMES_IN_FLIGHT> m_TransientPools;
+    std::vector<ResourceNode>   m_Resources;
+    std::vector<PassNode>       m_Passes;
+    std::vector<ScheduledPass>  m_Schedule;
+    BarrierBatch                m_BarrierBatch;
+    uint32_t                    m_FrameBarrierCount{0};
+    bool                        m_Compiled{false};
+};
@@ -0,0 +1,46 @@
+#include "Core/CnPch.hpp"
+#include "RenderPacket.hpp"
+
+#include "Scene/Scene.hpp"
+#include "Scene/SceneMember.hpp"
+#include "Asset/Mesh.hpp"
+#include "Asset/Material.hpp"
+
+void RenderPacket::Extract(const Scene& scene)
+{
+    CN_PROFILE_FUNCTION();
+
+    const Camera& sceneCamera = scene.GetCamera();
+    camera          = sceneCamera.GetBufferObject();
+    cameraPosition  = sceneCamera.GetPosition();
+    exposure        = sceneCamera.GetExposure();
+
+    // The vectors give their storage back before the arena reuses it, then take exactly what this frame needs
+    pointLights = std::pmr::vector<Lights::PointLight>(&arena);
+    draws       = std::pmr::vector<DrawItem>(&arena);
+    arena.Reset();
+
+    size_t drawCount = 0;
+    for(const SceneMember& sceneMember : scene.GetSceneMembers())
+    {
+        drawCount += sceneMember.GetMesh()->m_SubMeshes.size();
+    }
+
+    pointLights.assign(scene.GetPointLights().begin(), scene.GetPointLights().end());
+    draws.reserve(drawCount);
+    for(const SceneMember& sceneMember : scene.GetSceneMembers())
+    {
+        const std::vector<SubMesh>& submeshes = sceneMember.GetMesh()->m_SubMeshes;
+        const std::vector<Bounds::BoundingVolume>& worldBounds = sceneMember.GetSubMeshWorldBounds();
+        for(size_t i = 0; i < submeshes.size(); i++)
+        {
+            DrawItem draw{};
+            draw.model          = sceneMember.GetModelMatrix();
+            draw.localBounds    = submeshes[i].GetBounds().aabb;
+            draw.worldBounds    = worldBounds[i];
+            draw.materialIndex  = submeshes[i].GetMaterial()->GetIndex();
+            draw.geometry       = submeshes[i].GetGeometry();
+            draws.push_back(draw);
+        }
+    }
+}
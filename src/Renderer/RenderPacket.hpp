@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Asset/Bounds.hpp"
+#include "Core/LinearAllocator.hpp"
+#include "Buffer/GeometryArena.hpp"
+#include "Scene/Camera.hpp"
+#include "Scene/Lights.hpp"
+
+#include "glm/glm.hpp"
+
+class Scene;
+
+// Everything the renderer reads from a scene for one frame, copied out at the end of the main thread's frame.
+// The render thread only reads the packet, so the scene is free to change while the frame is recorded.
+// Packets are reused frame after frame, their vectors live in the packet's own arena which Extract recycles.
+struct RenderPacket
+{
+    RenderPacket() = default;
+
+    RenderPacket(const RenderPacket& otherPacket) = delete;
+    RenderPacket& operator=(const RenderPacket& otherPacket) = delete;
+
+    // One per submesh, in scene order
+    struct DrawItem
+    {
+        glm::mat4               model;
+        Bounds::AABB            localBounds;
+        Bounds::BoundingVolume  worldBounds;
+        uint32_t                materialIndex;
+        GeometryArena::Range    geometry;
+    };
+
+    // Declared before the vectors that allocate from it
+    LinearAllocator                         arena;
+    Camera::CameraBufferObject              camera;
+    glm::vec3                               cameraPosition;
+    float                                   exposure;
+    std::pmr::vector<Lights::PointLight>    pointLights{&arena};
+    std::pmr::vector<DrawItem>              draws{&arena};
+
+    void Extract(const Scene& scene);
+};
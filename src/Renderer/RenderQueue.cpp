@@ -0,0 +1,72 @@
+#include "Core/CnPch.hpp"
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include <bit>
+
+void RenderQueue::Clear()
+{
+    m_Items.clear();
+}
+
+void RenderQueue::Push(uint64_t key, uint32_t payload)
+{
+    m_Items.push_back({ key, payload });
+}
+
+uint64_t RenderQueue::MakeKey(uint32_t pipeline, uint32_t block, uint32_t material, float depth)
+{
+    if(pipeline > PIPELINE_MASK || block > BLOCK_MASK || material > MATERIAL_MASK)
+    {
+        throw std::runtime_error("Error: Draw does not fit into a render queue key.");
+    }
+
+    // Non negative floats order like their bit patterns, the top 24 bits keep the exponent and 15 bits of mantissa
+    uint32_t depthBits = std::bit_cast<uint32_t>(std::max(depth, 0.0f)) >> 8;
+
+    return (static_cast<uint64_t>(pipeline) << PIPELINE_SHIFT)
+         | (static_cast<uint64_t>(block) << BLOCK_SHIFT)
+         | (static_cast<uint64_t>(depthBits & DEPTH_MASK) << DEPTH_SHIFT)
+         | static_cast<uint64_t>(material);
+}
+
+void RenderQueue::Sort()
+{
+    CN_PROFILE_FUNCTION();
+
+    if(m_Items.size() < 2)
+    {
+        return;
+    }
+
+    m_Scratch.resize(m_Items.size());
+
+    // One byte per pass, least significant first. A byte that is the same in every key leaves the order as is,
+    // so the pass is skipped, which is most of them for a scene with one pipeline and a few blocks
+    for(uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        std::array<uint32_t, 256> offsets{};
+        for(const Item& item : m_Items)
+        {
+            offsets[(item.key >> shift) & 0xFF]++;
+        }
+        if(offsets[(m_Items.front().key >> shift) & 0xFF] == m_Items.size())
+        {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for(uint32_t& count : offsets)
+        {
+            uint32_t bucketCount = count;
+            count   = offset;
+            offset += bucketCount;
+        }
+        for(const Item& item : m_Items)
+        {
+            m_Scratch[offsets[(item.key >> shift) & 0xFF]++] = item;
+        }
+
+        m_Items.swap(m_Scratch);
+    }
+}
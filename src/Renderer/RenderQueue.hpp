@@ -0,0 +1,41 @@
+#pragma once
+
+// Orders draws by a 64 bit key with an LSD radix sort, which is stable and linear in the draw count.
+// From the most significant bits down: pipeline, geometry block, view depth and material, so each
+// pipeline and geometry block is bound once and draws inside them go front to back.
+class RenderQueue
+{
+public:
+    struct Item
+    {
+        uint64_t    key;
+        // Whatever the caller needs to find the draw again, usually an index into its own list
+        uint32_t    payload;
+    };
+public:
+    RenderQueue() = default;
+    ~RenderQueue() = default;
+
+    RenderQueue(const RenderQueue& otherQueue) = delete;
+    RenderQueue& operator=(const RenderQueue& otherQueue) = delete;
+public:
+    void Clear();
+    void Push(uint64_t key, uint32_t payload);
+    void Sort();
+public:
+    inline const std::vector<Item>& GetItems() const { return m_Items; }
+    // Depth is the squared view distance, 0 leaves it out so draws of a material stay together
+    static uint64_t MakeKey(uint32_t pipeline, uint32_t block, uint32_t material, float depth);
+    static inline uint32_t GetBlock(uint64_t key) { return static_cast<uint32_t>(key >> BLOCK_SHIFT) & BLOCK_MASK; }
+public:
+    inline static constexpr uint32_t PIPELINE_SHIFT = 60;
+    inline static constexpr uint32_t BLOCK_SHIFT    = 48;
+    inline static constexpr uint32_t DEPTH_SHIFT    = 24;
+    inline static constexpr uint32_t PIPELINE_MASK  = 0xF;
+    inline static constexpr uint32_t BLOCK_MASK     = 0xFFF;
+    inline static constexpr uint32_t DEPTH_MASK     = 0xFFFFFF;
+    inline static constexpr uint32_t MATERIAL_MASK  = 0xFFFFFF;
+private:
+    std::vector<Item>   m_Items;
+    std::vector<Item>   m_Scratch;
+};
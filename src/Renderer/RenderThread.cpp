@@ -0,0 +1,85 @@
+#include "Core/CnPch.hpp"
+#include "RenderThread.hpp"
+
+#include "Renderer.hpp"
+
+#include <utility>
+
+RenderThread::RenderThread(Renderer* renderer)
+    :   m_Renderer{renderer}
+{
+    for(RenderPacket& packet : m_Packets)
+    {
+        m_Drawn.Push(&packet);
+    }
+
+    m_Thread = std::thread(&RenderThread::Loop, this);
+}
+
+RenderPacket& RenderThread::AcquirePacket()
+{
+    CN_PROFILE_FUNCTION();
+
+    RenderPacket* packet = m_Drawn.Pop();
+    RethrowError();
+    return *packet;
+}
+
+void RenderThread::Submit(RenderPacket& packet)
+{
+    m_Submitted.Push(&packet);
+}
+
+void RenderThread::Stop()
+{
+    if(!m_Thread.joinable())
+    {
+        return;
+    }
+
+    m_Submitted.Push(nullptr);
+    m_Thread.join();
+    RethrowError();
+}
+
+void RenderThread::RethrowError()
+{
+    if(m_Error)
+    {
+        std::rethrow_exception(std::exchange(m_Error, nullptr));
+    }
+}
+
+void RenderThread::Loop()
+{
+    Profiler::SetThreadName("Render");
+
+    // m_Error belongs to the main thread once published, so the failure is remembered here
+    bool failed = false;
+    while(RenderPacket* packet = m_Submitted.Pop())
+    {
+        // After a failure the packets only cycle back, so the main thread never blocks on a dead thread
+        if(!failed)
+        {
+            try
+            {
+                m_Renderer->DrawFrame(*packet);
+            } catch(...)
+            {
+                m_Error = std::current_exception();
+                failed  = true;
+            }
+        }
+        m_Drawn.Push(packet);
+    }
+}
+
+RenderThread::~RenderThread()
+{
+    // Stop rethrows, which a destructor cannot
+    if(m_Thread.joinable())
+    {
+        m_Submitted.Push(nullptr);
+        m_Thread.join();
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "RenderPacket.hpp"
+#include "Core/SpscQueue.hpp"
+
+#include <thread>
+
+class Renderer;
+
+// Draws frames on its own thread from packets the main thread extracted, so the simulation of the next frame
+// overlaps with recording the current one. The main thread runs at most PACKET_COUNT - 1 frames ahead.
+class RenderThread
+{
+public:
+    explicit RenderThread(Renderer* renderer);
+    ~RenderThread();
+
+    RenderThread(const RenderThread& otherThread) = delete;
+    RenderThread& operator=(const RenderThread& otherThread) = delete;
+public:
+    // Main thread: a packet no frame reads anymore, blocks while the render thread catches up.
+    // Rethrows what the render thread threw while drawing an earlier packet
+    RenderPacket& AcquirePacket();
+    void Submit(RenderPacket& packet);
+    // Draws every submitted packet and joins the thread, rethrowing what it threw
+    void Stop();
+public:
+    inline static constexpr uint32_t PACKET_COUNT = 2;
+private:
+    void Loop();
+    void RethrowError();
+private:
+    Renderer*                                   m_Renderer;
+    std::array<RenderPacket, PACKET_COUNT>      m_Packets;
+    // nullptr asks the thread to stop, so the queue leaves room for it next to every packet
+    SpscQueue<RenderPacket*, PACKET_COUNT * 2>  m_Submitted;
+    SpscQueue<RenderPacket*, PACKET_COUNT * 2>  m_Drawn;
+    // Written before the packet goes back through m_Drawn, which publishes it to the main thread
+    std::exception_ptr                          m_Error;
+    std::thread                                 m_Thread;
+};
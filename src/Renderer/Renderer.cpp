@@ -4,40 +4,70 @@
 #include "Scene/Scene.hpp"
 #include "Scene/SceneMember.hpp"
 #include "Asset/Mesh.hpp"
-#include "Asset/Material.hpp"
+#include "Asset/AssetManager.hpp"
 #include "Context.hpp"
+#include "Core/JobSystem.hpp"
 
 #include "glm/gtc/matrix_transform.hpp"
 
-Renderer::Renderer(Context* context, Scene* scene)
-    :   m_Context{context}, m_ActiveScene{scene}, m_Swapchain{context}, m_CommandBuffers{},
-        m_InFlightFences{}, m_ImageAvailableSems{}, m_PresentSems{}, m_ImageIndex{}, m_FrameIndex{}
+Renderer::Renderer(Context* context, AssetManager* assetManager, Scene* scene, JobSystem* jobSystem, const RendererInfo& info)
+    :   m_Context{context}, m_AssetManager{assetManager}, m_ActiveScene{scene}, m_Packet{}, m_JobSystem{jobSystem}, m_Info{info}, m_CommandBuffers{},
+        m_InFlightFences{}, m_ImageAvailableSems{}, m_PresentSems{}, m_ImageIndex{}, m_FrameIndex{},
+        m_Headless{context->IsHeadless()}, m_GBufferHandles{}, m_DepthHandle{}, m_HDRHandle{}, m_OutputHandle{}, m_IndirectDrawing{true}, m_FrontToBack{true}, m_AttachmentSampler{}, m_DepthPrepassUsed{}, m_DepthPrepassSampleCount{0}, m_ParallelRecording{true}, m_GpuCulling{true}, m_OcclusionCulling{true}, m_CpuCulling{true}
 {
+    if(m_Headless)
+    {
+        CreateOffscreenTargets();
+    } else
+    {
+        m_Swapchain = std::make_unique<Swapchain>(context);
+    }
+
     Init();
-    m_ActiveScene->GetCamera().SetExtent(m_Swapchain.GetExtent());
+    m_ActiveScene->GetCamera().SetExtent(GetOutputExtent());
+}
+
+VkExtent2D Renderer::GetOutputExtent() const
+{
+    return m_Headless ? m_Context->GetSurfaceExtent() : m_Swapchain->GetExtent();
+}
+
+VkFormat Renderer::GetOutputFormat() const
+{
+    return m_Headless ? m_OffscreenTargets[0]->GetImageFormat() : m_Swapchain->GetFormat();
 }
 
 void Renderer::Init()
 {
     CreateCommandBuffers();
     CreateSyncResources();
-    CreateGeometryPassResources();
+    m_GpuProfiler = std::make_unique<GpuProfiler>(m_Context);
+    CreateRenderGraph();
+    CreateAttachmentSampler();
+    m_DrawList = std::make_unique<SceneDrawList>(m_Context);
     CreateGeometryPipeline();
+    CreateDepthPrepassPipeline();
+    CreateCullingPipeline();
     CreateLightingPassResources();
     CreateLightingPipeline();
+    CreateLightVolumePipelines();
     CreateTonemappingPassResources();
     CreateTonemappingPipeline();
 }
 
 void Renderer::CreateCommandBuffers()
 {
-    VkCommandBufferAllocateInfo cmdBufferInfo{};
-    cmdBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    cmdBufferInfo.commandPool = m_Context->GetCommandPool();
-    cmdBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    cmdBufferInfo.commandBufferCount = Swapchain::FRAMES_IN_FLIGHT;
+    m_CommandPools = std::make_unique<FrameCommandPools>(m_Context, m_JobSystem->GetThreadCount());
 
-    VK_CHECK(vkAllocateCommandBuffers(m_Context->GetLogicalDevice(), &cmdBufferInfo, m_CommandBuffers.data()))
+    for(size_t i = 0; i < Swapchain::FRAMES_IN_FLIGHT; i++)
+    {
+        m_CommandBuffers[i] = m_CommandPools->GetPrimary(i);
+    }
+
+    for(uint32_t i = 0; i < m_JobSystem->GetThreadCount(); i++)
+    {
+        m_ChunkRecorders.push_back(std::make_unique<CommandRecorder>());
+    }
 }
 
 void Renderer::CreateSyncResources()
@@ -54,238 +84,330 @@ void Renderer::CreateSyncResources()
     for(uint32_t i = 0; i < Swapchain::FRAMES_IN_FLIGHT; i++)
     {
         VK_CHECK(vkCreateFence(m_Context->GetLogicalDevice(), &fenceInfo, nullptr, &m_InFlightFences[i]))
-        VK_CHECK(vkCreateSemaphore(m_Context->GetLogicalDevice(), &semaphoreInfo, nullptr, &m_ImageAvailableSems[i]))
-        VK_CHECK(vkCreateSemaphore(m_Context->GetLogicalDevice(), &semaphoreInfo, nullptr, &m_PresentSems[i]))
+
+        // Headless frames are paced by the in-flight fences alone
+        if(!m_Headless)
+        {
+            VK_CHECK(vkCreateSemaphore(m_Context->GetLogicalDevice(), &semaphoreInfo, nullptr, &m_ImageAvailableSems[i]))
+            VK_CHECK(vkCreateSemaphore(m_Context->GetLogicalDevice(), &semaphoreInfo, nullptr, &m_PresentSems[i]))
+        }
     }
 }
 
-void Renderer::CreateGeometryPassResources()
+void Renderer::CreateOffscreenTargets()
 {
-    // Create GBuffer
-    for(size_t i = 0; i < m_GeometryBuffer.max_size(); i++)
+    // Stand-ins for the swapchain images when there is no surface to present to
+    Image::ImageInfo targetInfo{};
+    targetInfo.format           = VK_FORMAT_B8G8R8A8_SRGB;
+    targetInfo.desiredLayout    = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    targetInfo.dimension        = m_Context->GetSurfaceExtent();
+    targetInfo.usageFlags       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    targetInfo.aspectFlags      = VK_IMAGE_ASPECT_COLOR_BIT;
+    targetInfo.genMipmaps       = VK_FALSE;
+
+    for(size_t i = 0; i < m_OffscreenTargets.max_size(); i++)
     {
-        std::vector<Framebuffer::AttachmentInfo> gBufferAttachments;
-        gBufferAttachments.resize(4);
-
-        // Albedo Attachment
-        gBufferAttachments[0].format        = m_Swapchain.GetFormat();
-        gBufferAttachments[0].layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        gBufferAttachments[0].usageFlags    = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-        gBufferAttachments[0].aspectFlags   = VK_IMAGE_ASPECT_COLOR_BIT;
-
-        // Position Attachment
-        gBufferAttachments[1].format        = VK_FORMAT_R16G16B16A16_SFLOAT;
-        gBufferAttachments[1].layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        gBufferAttachments[1].usageFlags    = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-        gBufferAttachments[1].aspectFlags   = VK_IMAGE_ASPECT_COLOR_BIT;
-
-        // Normal Attachment
-        gBufferAttachments[2].format        = VK_FORMAT_R16G16B16A16_SFLOAT;
-        gBufferAttachments[2].layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        gBufferAttachments[2].usageFlags    = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-        gBufferAttachments[2].aspectFlags   = VK_IMAGE_ASPECT_COLOR_BIT;
-
-        // Depth Attachment
-        gBufferAttachments[3].format        = VK_FORMAT_D32_SFLOAT;
-        gBufferAttachments[3].layout        = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
-        gBufferAttachments[3].usageFlags    = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-        gBufferAttachments[3].aspectFlags   = VK_IMAGE_ASPECT_DEPTH_BIT;
-
-        m_GeometryBuffer[i] = std::make_unique<Framebuffer>(m_Context, m_Swapchain.GetExtent(), gBufferAttachments);
+        m_OffscreenTargets[i] = std::make_unique<Image>(m_Context, targetInfo);
     }
 }
 
-void Renderer::CreateGeometryPipeline()
+void Renderer::CreateAttachmentSampler()
 {
-    VkPushConstantRange cameraPushConstant{};
-    cameraPushConstant.stageFlags    = VK_SHADER_STAGE_VERTEX_BIT;
-    cameraPushConstant.offset        = 0;
-    cameraPushConstant.size          = sizeof(glm::mat4);
-
-    VkPushConstantRange materialPushConstant{};
-    materialPushConstant.stageFlags    = VK_SHADER_STAGE_FRAGMENT_BIT;
-    materialPushConstant.offset        = sizeof(glm::mat4);
-    materialPushConstant.size          = sizeof(Material::MaterialObject);
+    // Attachments are read one texel per pixel at the size they were rendered, filtering would only cost bandwidth
+    VkSamplerCreateInfo samplerCreateInfo{};
+    samplerCreateInfo.sType             = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerCreateInfo.magFilter         = VK_FILTER_NEAREST;
+    samplerCreateInfo.minFilter         = VK_FILTER_NEAREST;
+    samplerCreateInfo.addressModeU      = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeV      = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeW      = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.anisotropyEnable  = VK_FALSE;
+
+    samplerCreateInfo.maxAnisotropy             = 1.0f;
+    samplerCreateInfo.borderColor               = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+    samplerCreateInfo.unnormalizedCoordinates   = VK_FALSE;
+    samplerCreateInfo.compareEnable             = VK_FALSE;
+    samplerCreateInfo.compareOp                 = VK_COMPARE_OP_ALWAYS;
+    samplerCreateInfo.mipmapMode                = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerCreateInfo.mipLodBias                = 0.0f;
+    samplerCreateInfo.minLod                    = 0.0f;
+    samplerCreateInfo.maxLod                    = 0.0f;
+
+    VK_CHECK(vkCreateSampler(m_Context->GetLogicalDevice(), &samplerCreateInfo, nullptr, &m_AttachmentSampler))
+}
 
+void Renderer::CreateGeometryPipeline()
+{
     std::vector<VkFormat> colorFormats;
-    for(size_t i = 0; i < m_GeometryBuffer[0]->GetAttachments().size() - 1; i++)
+    for(RenderGraph::ResourceHandle handle : m_GBufferHandles)
     {
-        colorFormats.push_back(m_GeometryBuffer[0]->GetAttachments()[i].GetImageFormat());
+        colorFormats.push_back(m_RenderGraph->GetImage(handle, 0)->GetImageFormat());
     }
-    VkFormat depthFormat = m_GeometryBuffer[0]->GetAttachments()[m_GeometryBuffer[0]->GetAttachments().size() - 1].GetImageFormat();
+    VkFormat depthFormat = m_RenderGraph->GetImage(m_DepthHandle, 0)->GetImageFormat();
 
     Pipeline::PipelineInfo pipeInfo{};
     pipeInfo.vertexPath         = "/Shaders/GeometryVert.spv";
-    pipeInfo.fragmentPath       = "/Shaders/GeometryFrag.spv";
+    pipeInfo.fragmentPath       = m_Info.compactGBuffer ? "/Shaders/GeometryCompactFrag.spv" : "/Shaders/GeometryFrag.spv";
     pipeInfo.colorFormats       = colorFormats;
     pipeInfo.depthFormat        = depthFormat;
-    pipeInfo.extent             = m_Swapchain.GetExtent();
+    pipeInfo.extent             = GetOutputExtent();
     pipeInfo.cullMode           = VK_CULL_MODE_BACK_BIT;
     pipeInfo.depthTest          = VK_TRUE;
     pipeInfo.depthWrite         = VK_TRUE;
     pipeInfo.vertexBindings     = VK_TRUE;
     pipeInfo.enableBlend        = VK_FALSE;
-    pipeInfo.layouts            = { m_ActiveScene->GetCamera().GetCameraLayout(), m_ActiveScene->GetSceneMembers()[0].GetMesh()->m_SubMeshes[0].GetMaterial()->GetLayout() };
-    pipeInfo.pushConstants      = { cameraPushConstant, materialPushConstant };
+    // Model matrices and material indices come from the draw list, materials from the bindless table
+    pipeInfo.layouts            = { m_ActiveScene->GetCamera().GetCameraLayout(), m_AssetManager->GetMaterialTable().GetDescriptorSetLayout(), m_DrawList->GetDescriptorSetLayout() };
+    pipeInfo.pushConstants      = {};
+
+    pipeInfo.name               = "Geometry";
+    pipeInfo.profiler           = m_GpuProfiler.get();
+    pipeInfo.recorder           = &m_CommandRecorder;
 
     m_GeometryPipeline = std::make_unique<Pipeline>(m_Context, pipeInfo);
+
+    // Same shaders over the depth the pre-pass laid down, only the nearest surface of every pixel is shaded
+    pipeInfo.depthWrite         = VK_FALSE;
+    pipeInfo.depthCompareOp     = VK_COMPARE_OP_EQUAL;
+
+    m_GeometryEqualPipeline = std::make_unique<Pipeline>(m_Context, pipeInfo);
 }
 
-void Renderer::CreateLightObjects()
+void Renderer::CreateDepthPrepassPipeline()
 {
-    Lights::LightBufferObject lbo{};
+    // Geometry.frag never discards, so the position alone decides which surface ends up nearest
+    Pipeline::PipelineInfo pipeInfo{};
+    pipeInfo.vertexPath         = "/Shaders/DepthPrepassVert.spv";
+    pipeInfo.fragmentPath       = {};
+    pipeInfo.colorFormats       = {};
+    pipeInfo.depthFormat        = m_RenderGraph->GetImage(m_DepthHandle, 0)->GetImageFormat();
+    pipeInfo.extent             = GetOutputExtent();
+    pipeInfo.cullMode           = VK_CULL_MODE_BACK_BIT;
+    pipeInfo.depthTest          = VK_TRUE;
+    pipeInfo.depthWrite         = VK_TRUE;
+    pipeInfo.vertexBindings     = VK_TRUE;
+    pipeInfo.enableBlend        = VK_FALSE;
+    // The geometry pipeline's layouts, so the draw list stays at set 2. The material table is never read
+    pipeInfo.layouts            = { m_ActiveScene->GetCamera().GetCameraLayout(), m_AssetManager->GetMaterialTable().GetDescriptorSetLayout(), m_DrawList->GetDescriptorSetLayout() };
+    pipeInfo.pushConstants      = {};
 
-    for(size_t i = 0; i < m_ActiveScene->GetPointLights().size(); i++)
-    {
-        lbo.pointlights[i]  = m_ActiveScene->GetPointLights()[i];
-        lbo.numPointLights++;
-    }
+    pipeInfo.name               = "DepthPrepass";
+    pipeInfo.profiler           = m_GpuProfiler.get();
+    pipeInfo.recorder           = &m_CommandRecorder;
 
-    lbo.viewPos     = m_ActiveScene->GetCamera().GetPosition();
-    lbo.viewMatrix  = m_ActiveScene->GetCamera().CreateCameraMatrix();
+    m_DepthPrepassPipeline = std::make_unique<Pipeline>(m_Context, pipeInfo);
+}
 
-    for(size_t i = 0; i < m_LightsObjects.max_size(); i++)
+void Renderer::CreateCullingPipeline()
+{
+    // Built from the G-buffer depth between the early and the late geometry pass
+    std::vector<const Image*> depthImages;
+    for(size_t i = 0; i < Swapchain::FRAMES_IN_FLIGHT; i++)
     {
-        m_LightsObjects[i] = lbo;
+        depthImages.push_back(m_RenderGraph->GetImage(m_DepthHandle, i));
     }
+    m_DepthPyramid = std::make_unique<DepthPyramid>(m_Context, depthImages, m_GpuProfiler.get(), &m_CommandRecorder);
+
+    VkPushConstantRange paramsPushConstant{};
+    paramsPushConstant.stageFlags   = VK_SHADER_STAGE_COMPUTE_BIT;
+    paramsPushConstant.offset       = 0U;
+    paramsPushConstant.size         = sizeof(SceneDrawList::CullingParams);
+
+    ComputePipeline::PipelineInfo pipeInfo{};
+    pipeInfo.computePath    = "/Shaders/CullingComp.spv";
+    pipeInfo.layouts        = { m_ActiveScene->GetCamera().GetCameraLayout(), m_DrawList->GetDescriptorSetLayout(), m_DepthPyramid->GetDescriptorSetLayout() };
+    pipeInfo.pushConstants  = { paramsPushConstant };
+
+    pipeInfo.name           = "Culling";
+    pipeInfo.profiler       = m_GpuProfiler.get();
+    pipeInfo.recorder       = &m_CommandRecorder;
+
+    m_CullingPipeline = std::make_unique<ComputePipeline>(m_Context, pipeInfo);
 }
 
-void Renderer::CreateLightBuffers()
+void Renderer::CreateLightingPassResources()
 {
-    for(size_t i = 0; i < m_LightsBuffers.max_size(); i++)
+    m_LightClusters     = std::make_unique<LightClusters>(m_Context, GetOutputExtent(), m_GpuProfiler.get(), &m_CommandRecorder);
+    m_LightVolumeMesh   = std::make_unique<LightVolumeMesh>(m_Context);
+
+    for(size_t i = 0; i < static_cast<uint32_t>(Swapchain::FRAMES_IN_FLIGHT); i++)
     {
-        Buffer::BufferInfo bufferInfo{};
-        bufferInfo.size = sizeof(Lights::LightBufferObject);
-        bufferInfo.usageFlags = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-        bufferInfo.vmaMemoryUsage = VMA_MEMORY_USAGE_AUTO;
-        bufferInfo.vmaAllocFlags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        m_GBufferDescriptorSets[i]          = CreateGBufferDescriptorSet(i, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        m_DepthReadGBufferDescriptorSets[i] = CreateGBufferDescriptorSet(i, VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_OPTIMAL);
+    }
 
-        m_LightsBuffers[i] = std::make_unique<Buffer>(m_Context, bufferInfo);
-        m_LightsBuffers[i]->Map(&m_LightsObjects[i], sizeof(Lights::LightBufferObject));
+    if(m_Info.compactHDR)
+    {
+        return;
     }
-}
 
-void Renderer::UpdateLights()
-{
-    for(size_t i = 0; i < m_LightsObjects.size(); i++)
+    // The compute lighting pass writes the HDR target as a storage image
+    for(size_t i = 0; i < m_HDRStorageDescriptorSets.size(); i++)
     {
-        for(size_t j = 0; j < m_LightsObjects[i].numPointLights; j++)
-        {
-            m_LightsObjects[i].pointlights[j].position  = m_ActiveScene->GetPointLights()[j].position;
-            m_LightsObjects[i].pointlights[j].color     = m_ActiveScene->GetPointLights()[j].color;
-        }
-        m_LightsObjects[i].viewPos      = m_ActiveScene->GetCamera().GetPosition();
-        m_LightsObjects[i].viewMatrix   = m_ActiveScene->GetCamera().CreateCameraMatrix();
-        m_LightsBuffers[i]->Map(&m_LightsObjects[i], sizeof(Lights::LightBufferObject));
+        VkDescriptorImageInfo hdrStorageInfo{};
+        hdrStorageInfo.imageView    = m_RenderGraph->GetImage(m_HDRHandle, i)->GetImageView();
+        hdrStorageInfo.imageLayout  = VK_IMAGE_LAYOUT_GENERAL;
+
+        DescriptorSet::BindingInfo hdrStorageBinding{};
+        hdrStorageBinding.type          = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        hdrStorageBinding.binding       = 0;
+        hdrStorageBinding.stageFlags    = VK_SHADER_STAGE_COMPUTE_BIT;
+        hdrStorageBinding.imageInfo     = &hdrStorageInfo;
+
+        std::vector<DescriptorSet::BindingInfo> hdrStorageBindings = { hdrStorageBinding };
+        m_HDRStorageDescriptorSets[i] = std::make_unique<DescriptorSet>(m_Context, hdrStorageBindings);
     }
 }
 
-void Renderer::CreateLightingPassResources()
+std::unique_ptr<DescriptorSet> Renderer::CreateGBufferDescriptorSet(size_t frameIndex, VkImageLayout depthLayout) const
 {
-    CreateLightObjects();
-    CreateLightBuffers();
-
-    for(size_t i = 0; i < static_cast<uint32_t>(Swapchain::FRAMES_IN_FLIGHT); i++)
-    {
-        // Albedo
-        VkDescriptorImageInfo albedoDescriptorInfo{};
-        albedoDescriptorInfo.sampler       = m_GeometryBuffer[i]->GetSampler();
-        albedoDescriptorInfo.imageView     = m_GeometryBuffer[i]->GetAttachments()[0].GetImageView();
-        albedoDescriptorInfo.imageLayout   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        DescriptorSet::BindingInfo albedoSamplerBinding{};
-        albedoSamplerBinding.type       = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        albedoSamplerBinding.binding    = 0;
-        albedoSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-        albedoSamplerBinding.imageInfo  = &albedoDescriptorInfo;
-
-        // Position
-        VkDescriptorImageInfo positionDescriptorInfo{};
-        positionDescriptorInfo.sampler       = m_GeometryBuffer[i]->GetSampler();
-        positionDescriptorInfo.imageView     = m_GeometryBuffer[i]->GetAttachments()[1].GetImageView();
-        positionDescriptorInfo.imageLayout   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        DescriptorSet::BindingInfo positionSamplerBinding{};
-        positionSamplerBinding.type       = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        positionSamplerBinding.binding    = 1;
-        positionSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-        positionSamplerBinding.imageInfo  = &positionDescriptorInfo;
-
-        // Normal
-        VkDescriptorImageInfo normalDescriptorInfo{};
-        normalDescriptorInfo.sampler       = m_GeometryBuffer[i]->GetSampler();
-        normalDescriptorInfo.imageView     = m_GeometryBuffer[i]->GetAttachments()[2].GetImageView();
-        normalDescriptorInfo.imageLayout   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        DescriptorSet::BindingInfo normalSamplerBinding{};
-        normalSamplerBinding.type       = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        normalSamplerBinding.binding    = 2;
-        normalSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-        normalSamplerBinding.imageInfo  = &normalDescriptorInfo;
-
-        // Lights
-        VkDescriptorBufferInfo lightBufferInfo{};
-        lightBufferInfo.buffer   = m_LightsBuffers[i]->GetBuffer();
-        lightBufferInfo.offset   = 0;
-        lightBufferInfo.range    = sizeof(Lights::LightBufferObject);
-
-        DescriptorSet::BindingInfo lightBufferBinding{};
-        lightBufferBinding.type         = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        lightBufferBinding.binding      = 3;
-        lightBufferBinding.stageFlags   = VK_SHADER_STAGE_FRAGMENT_BIT;
-        lightBufferBinding.bufferInfo   = &lightBufferInfo;
-
-        std::vector<DescriptorSet::BindingInfo> bindings =
-                {
-                    albedoSamplerBinding,
-                    positionSamplerBinding,
-                    normalSamplerBinding,
-                    lightBufferBinding
-                };
-
-        m_GBufferDescriptorSets[i] = std::make_unique<DescriptorSet>(m_Context, bindings);
-    }
-
-    Image::ImageInfo hdrImage{};
-    hdrImage.format         = VK_FORMAT_R16G16B16A16_SFLOAT;
-    hdrImage.desiredLayout  = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    hdrImage.dimension      = m_Swapchain.GetExtent();
-    hdrImage.usageFlags     = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-    hdrImage.aspectFlags    = VK_IMAGE_ASPECT_COLOR_BIT;
-    hdrImage.genMipmaps     = VK_FALSE;
-
-    for(size_t i = 0; i < m_HDRImages.max_size(); i++)
-    {
-        m_HDRImages[i] = std::make_unique<Image>(m_Context, hdrImage);
-    }
+    // Albedo
+    VkDescriptorImageInfo albedoDescriptorInfo{};
+    albedoDescriptorInfo.sampler       = m_AttachmentSampler;
+    albedoDescriptorInfo.imageView     = m_RenderGraph->GetImage(m_GBufferHandles.front(), frameIndex)->GetImageView();
+    albedoDescriptorInfo.imageLayout   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    DescriptorSet::BindingInfo albedoSamplerBinding{};
+    albedoSamplerBinding.type       = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    albedoSamplerBinding.binding    = 0;
+    albedoSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+    albedoSamplerBinding.imageInfo  = &albedoDescriptorInfo;
+
+    // Position, or the depth it is reconstructed from
+    VkDescriptorImageInfo positionDescriptorInfo{};
+    positionDescriptorInfo.sampler       = m_AttachmentSampler;
+    positionDescriptorInfo.imageView     = m_RenderGraph->GetImage(m_Info.compactGBuffer ? m_DepthHandle : m_GBufferHandles[1], frameIndex)->GetImageView();
+    positionDescriptorInfo.imageLayout   = m_Info.compactGBuffer ? depthLayout : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    DescriptorSet::BindingInfo positionSamplerBinding{};
+    positionSamplerBinding.type       = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    positionSamplerBinding.binding    = 1;
+    positionSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+    positionSamplerBinding.imageInfo  = &positionDescriptorInfo;
+
+    // Normal
+    VkDescriptorImageInfo normalDescriptorInfo{};
+    normalDescriptorInfo.sampler       = m_AttachmentSampler;
+    normalDescriptorInfo.imageView     = m_RenderGraph->GetImage(m_GBufferHandles.back(), frameIndex)->GetImageView();
+    normalDescriptorInfo.imageLayout   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    DescriptorSet::BindingInfo normalSamplerBinding{};
+    normalSamplerBinding.type       = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    normalSamplerBinding.binding    = 2;
+    normalSamplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+    normalSamplerBinding.imageInfo  = &normalDescriptorInfo;
+
+    std::vector<DescriptorSet::BindingInfo> bindings =
+            {
+                albedoSamplerBinding,
+                positionSamplerBinding,
+                normalSamplerBinding
+            };
+
+    return std::make_unique<DescriptorSet>(m_Context, bindings);
 }
 
 void Renderer::CreateLightingPipeline()
 {
-    // Full screen quad for now. Bounding spheres planned.
+    // Full screen quad shading the light clusters
     Pipeline::PipelineInfo pipeInfo{};
     pipeInfo.vertexPath         = "/Shaders/FullScreenQuadVert.spv";
-    pipeInfo.fragmentPath       = "/Shaders/LightingFrag.spv";
-    pipeInfo.colorFormats       = { m_HDRImages[0]->GetImageFormat() };
-    pipeInfo.extent             = m_Swapchain.GetExtent();
+    pipeInfo.fragmentPath       = m_Info.compactGBuffer ? "/Shaders/LightingCompactFrag.spv" : "/Shaders/LightingFrag.spv";
+    pipeInfo.colorFormats       = { m_RenderGraph->GetImage(m_HDRHandle, 0)->GetImageFormat() };
+    pipeInfo.extent             = GetOutputExtent();
     pipeInfo.cullMode           = VK_CULL_MODE_FRONT_BIT;
     pipeInfo.depthTest          = VK_FALSE;
     pipeInfo.depthWrite         = VK_FALSE;
     pipeInfo.vertexBindings     = VK_FALSE;
     pipeInfo.enableBlend        = VK_FALSE;
-    pipeInfo.layouts            = { m_GBufferDescriptorSets[0]->GetDescriptorSetLayout() };
+    pipeInfo.layouts            = { m_GBufferDescriptorSets[0]->GetDescriptorSetLayout(), m_LightClusters->GetDescriptorSetLayout() };
+
+    pipeInfo.name               = "Lighting";
+    pipeInfo.profiler           = m_GpuProfiler.get();
+    pipeInfo.recorder           = &m_CommandRecorder;
 
     m_LightingPipeline = std::make_unique<Pipeline>(m_Context, pipeInfo);
+
+    if(m_Info.compactHDR)
+    {
+        return;
+    }
+
+    // Same shading in tiles of LIGHTING_TILE_SIZE pixels, each culling the lights against its own depth range
+    ComputePipeline::PipelineInfo computeInfo{};
+    computeInfo.computePath = m_Info.compactGBuffer ? "/Shaders/ComputeLightingCompactComp.spv" : "/Shaders/ComputeLightingComp.spv";
+    computeInfo.layouts     =
+            {
+                m_GBufferDescriptorSets[0]->GetDescriptorSetLayout(),
+                m_LightClusters->GetDescriptorSetLayout(),
+                m_HDRStorageDescriptorSets[0]->GetDescriptorSetLayout()
+            };
+
+    computeInfo.name        = "ComputeLighting";
+    computeInfo.profiler    = m_GpuProfiler.get();
+    computeInfo.recorder    = &m_CommandRecorder;
+
+    m_ComputeLightingPipeline = std::make_unique<ComputePipeline>(m_Context, computeInfo);
+}
+
+void Renderer::CreateLightVolumePipelines()
+{
+    // Full screen quad for the ambient term, the light volumes are added on top
+    Pipeline::PipelineInfo ambientInfo{};
+    ambientInfo.vertexPath      = "/Shaders/FullScreenQuadVert.spv";
+    ambientInfo.fragmentPath    = "/Shaders/AmbientFrag.spv";
+    ambientInfo.colorFormats    = { m_RenderGraph->GetImage(m_HDRHandle, 0)->GetImageFormat() };
+    ambientInfo.extent          = GetOutputExtent();
+    ambientInfo.cullMode        = VK_CULL_MODE_FRONT_BIT;
+    ambientInfo.depthTest       = VK_FALSE;
+    ambientInfo.depthWrite      = VK_FALSE;
+    ambientInfo.vertexBindings  = VK_FALSE;
+    ambientInfo.enableBlend     = VK_FALSE;
+    ambientInfo.layouts         = { m_GBufferDescriptorSets[0]->GetDescriptorSetLayout() };
+
+    ambientInfo.name            = "Ambient";
+    ambientInfo.profiler        = m_GpuProfiler.get();
+    ambientInfo.recorder        = &m_CommandRecorder;
+
+    m_AmbientPipeline = std::make_unique<Pipeline>(m_Context, ambientInfo);
+
+    // Back faces pass where they lie behind the G-buffer depth, which also covers a camera inside the volume
+    Pipeline::PipelineInfo volumeInfo{};
+    volumeInfo.vertexPath       = "/Shaders/LightVolumeVert.spv";
+    volumeInfo.fragmentPath     = m_Info.compactGBuffer ? "/Shaders/LightVolumeCompactFrag.spv" : "/Shaders/LightVolumeFrag.spv";
+    volumeInfo.colorFormats     = { m_RenderGraph->GetImage(m_HDRHandle, 0)->GetImageFormat() };
+    volumeInfo.depthFormat      = m_RenderGraph->GetImage(m_DepthHandle, 0)->GetImageFormat();
+    volumeInfo.extent           = GetOutputExtent();
+    volumeInfo.cullMode         = VK_CULL_MODE_FRONT_BIT;
+    volumeInfo.depthTest        = VK_TRUE;
+    volumeInfo.depthWrite       = VK_FALSE;
+    volumeInfo.depthCompareOp   = VK_COMPARE_OP_GREATER_OR_EQUAL;
+    volumeInfo.vertexBindings   = VK_FALSE;
+    volumeInfo.enableBlend      = VK_TRUE;
+    volumeInfo.additiveBlend    = VK_TRUE;
+    volumeInfo.layouts          =
+            {
+                m_GBufferDescriptorSets[0]->GetDescriptorSetLayout(),
+                m_LightClusters->GetDescriptorSetLayout(),
+                m_ActiveScene->GetCamera().GetCameraLayout(),
+                m_LightVolumeMesh->GetDescriptorSetLayout()
+            };
+
+    volumeInfo.name             = "LightVolumes";
+    volumeInfo.profiler         = m_GpuProfiler.get();
+    volumeInfo.recorder         = &m_CommandRecorder;
+
+    m_LightVolumePipeline = std::make_unique<Pipeline>(m_Context, volumeInfo);
 }
 
 void Renderer::CreateTonemappingPassResources()
 {
     // HDR Descriptor Sets
-    for(size_t i = 0; i < m_HDRImages.size(); i++)
+    for(size_t i = 0; i < m_HDRDescriptorSets.size(); i++)
     {
         VkDescriptorImageInfo imageInfo{};
-        imageInfo.sampler       = m_GeometryBuffer[0]->GetSampler();
-        imageInfo.imageView     = m_HDRImages[i]->GetImageView();
+        imageInfo.sampler       = m_AttachmentSampler;
+        imageInfo.imageView     = m_RenderGraph->GetImage(m_HDRHandle, i)->GetImageView();
         imageInfo.imageLayout   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
         DescriptorSet::BindingInfo bindingInfo{};
@@ -310,8 +432,8 @@ void Renderer::CreateTonemappingPipeline()
     Pipeline::PipelineInfo pipeInfo{};
     pipeInfo.vertexPath         = "/Shaders/FullScreenQuadVert.spv";
     pipeInfo.fragmentPath       = "/Shaders/TonemappingFrag.spv";
-    pipeInfo.colorFormats       = { m_Swapchain.GetFormat() };
-    pipeInfo.extent             = m_Swapchain.GetExtent();
+    pipeInfo.colorFormats       = { GetOutputFormat() };
+    pipeInfo.extent             = GetOutputExtent();
     pipeInfo.cullMode           = VK_CULL_MODE_FRONT_BIT;
     pipeInfo.depthTest          = VK_FALSE;
     pipeInfo.depthWrite         = VK_FALSE;
@@ -320,127 +442,477 @@ void Renderer::CreateTonemappingPipeline()
     pipeInfo.layouts            = { m_HDRDescriptorSets[0]->GetDescriptorSetLayout() };
     pipeInfo.pushConstants      = { exposurePushConstant };
 
+    pipeInfo.name               = "Tonemapping";
+    pipeInfo.profiler           = m_GpuProfiler.get();
+    pipeInfo.recorder           = &m_CommandRecorder;
+
     m_TonemappingPipeline = std::make_unique<Pipeline>(m_Context, pipeInfo);
 }
 
-void Renderer::GeometryPass()
+void Renderer::CreateRenderGraph()
 {
-    // Change GBuffer Image Layouts to VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-    for(size_t i = 0; i < m_GeometryBuffer[m_FrameIndex]->GetAttachments().size() - 1; i++)
+    m_RenderGraph = std::make_unique<RenderGraph>(m_Context);
+
+    // Every frame in flight gets its own set of attachments, memory is only aliased between the passes of a frame
+    m_GBufferHandles.push_back(m_RenderGraph->CreateImage("Albedo", { GetOutputFormat(), GetOutputExtent(), VK_IMAGE_ASPECT_COLOR_BIT }));
+    if(m_Info.compactGBuffer)
     {
-        m_GeometryBuffer[m_FrameIndex]->GetAttachments()[i].ChangeLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+        // Octahedral normal in RG, roughness in B and metallic in the two bit A channel, 8 bytes of colour per pixel instead of 20
+        m_GBufferHandles.push_back(m_RenderGraph->CreateImage("Normal", { VK_FORMAT_A2B10G10R10_UNORM_PACK32, GetOutputExtent(), VK_IMAGE_ASPECT_COLOR_BIT }));
+    } else
+    {
+        m_GBufferHandles.push_back(m_RenderGraph->CreateImage("Position", { VK_FORMAT_R16G16B16A16_SFLOAT, GetOutputExtent(), VK_IMAGE_ASPECT_COLOR_BIT }));
+        m_GBufferHandles.push_back(m_RenderGraph->CreateImage("Normal", { VK_FORMAT_R16G16B16A16_SFLOAT, GetOutputExtent(), VK_IMAGE_ASPECT_COLOR_BIT }));
+    }
+    m_DepthHandle   = m_RenderGraph->CreateImage("Depth", { VK_FORMAT_D32_SFLOAT, GetOutputExtent(), VK_IMAGE_ASPECT_DEPTH_BIT });
+    m_HDRHandle     = m_RenderGraph->CreateImage("HDR", { m_Info.compactHDR ? VK_FORMAT_B10G11R11_UFLOAT_PACK32 : VK_FORMAT_R16G16B16A16_SFLOAT, GetOutputExtent(), VK_IMAGE_ASPECT_COLOR_BIT });
+    m_OutputHandle  = m_RenderGraph->ImportImage("Output");
+
+    // Culling Pass, its indirect buffers live outside the graph so it is kept through side effects
+    RenderGraph::PassInfo cullingPass{};
+    cullingPass.name        = "Culling";
+    cullingPass.sideEffects = true;
+    cullingPass.execute     = [this](VkCommandBuffer commandBuffer, const Pipeline::RenderInfo&) { CullingPass(commandBuffer, SceneDrawList::EarlyPhase); };
+    m_RenderGraph->AddPass(std::move(cullingPass));
+
+    // Depth Pre-Pass, clears depth and draws into it on the frames that use the pre-pass
+    const bool depthPrepass = m_Info.depthPrepass != DepthPrepassMode::Off;
+    if(depthPrepass)
+    {
+        RenderGraph::PassInfo depthPrepassPass{};
+        depthPrepassPass.name = "DepthPrepass";
+        depthPrepassPass.usages.push_back({ m_DepthHandle, RenderGraph::Access::DepthAttachmentWrite, VK_ATTACHMENT_LOAD_OP_CLEAR, {.depthStencil{1.0f, 0}} });
+        depthPrepassPass.execute = [this](VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo) { DepthPrepass(commandBuffer, renderInfo); };
+        m_RenderGraph->AddPass(std::move(depthPrepassPass));
     }
 
-    std::vector<Pipeline::Attachment> colorAttachments;
+    // Geometry Pass, clears depth itself without a pre-pass
+    RenderGraph::PassInfo geometryPass{};
+    geometryPass.name = "Geometry";
+    for(RenderGraph::ResourceHandle handle : m_GBufferHandles)
+    {
+        geometryPass.usages.push_back({ handle, RenderGraph::Access::ColorAttachmentWrite, VK_ATTACHMENT_LOAD_OP_CLEAR, {} });
+    }
+    geometryPass.usages.push_back({ m_DepthHandle, RenderGraph::Access::DepthAttachmentWrite, depthPrepass ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR, {.depthStencil{1.0f, 0}} });
+    geometryPass.execute = [this](VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo) { GeometryPass(commandBuffer, renderInfo, SceneDrawList::EarlyPhase); };
+    m_RenderGraph->AddPass(std::move(geometryPass));
+
+    // Depth Pyramid Pass, from what the early geometry pass drew
+    RenderGraph::PassInfo depthPyramidPass{};
+    depthPyramidPass.name           = "DepthPyramid";
+    depthPyramidPass.sideEffects    = true;
+    depthPyramidPass.usages.push_back({ m_DepthHandle, RenderGraph::Access::ComputeSampledRead, VK_ATTACHMENT_LOAD_OP_DONT_CARE, {} });
+    depthPyramidPass.execute        = [this](VkCommandBuffer commandBuffer, const Pipeline::RenderInfo&) { DepthPyramidPass(commandBuffer); };
+    m_RenderGraph->AddPass(std::move(depthPyramidPass));
+
+    // Late Culling Pass
+    RenderGraph::PassInfo lateCullingPass{};
+    lateCullingPass.name        = "LateCulling";
+    lateCullingPass.sideEffects = true;
+    lateCullingPass.execute     = [this](VkCommandBuffer commandBuffer, const Pipeline::RenderInfo&) { CullingPass(commandBuffer, SceneDrawList::LatePhase); };
+    m_RenderGraph->AddPass(std::move(lateCullingPass));
+
+    // Late Geometry Pass, adds the draws that were hidden last frame but are visible now
+    RenderGraph::PassInfo lateGeometryPass{};
+    lateGeometryPass.name = "LateGeometry";
+    for(RenderGraph::ResourceHandle handle : m_GBufferHandles)
+    {
+        lateGeometryPass.usages.push_back({ handle, RenderGraph::Access::ColorAttachmentWrite, VK_ATTACHMENT_LOAD_OP_LOAD, {} });
+    }
+    lateGeometryPass.usages.push_back({ m_DepthHandle, RenderGraph::Access::DepthAttachmentWrite, VK_ATTACHMENT_LOAD_OP_LOAD, {} });
+    lateGeometryPass.execute = [this](VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo) { GeometryPass(commandBuffer, renderInfo, SceneDrawList::LatePhase); };
+    m_RenderGraph->AddPass(std::move(lateGeometryPass));
+
+    // Light Culling Pass, bins the lights into the clusters the lighting pass reads
+    RenderGraph::PassInfo lightCullingPass{};
+    lightCullingPass.name           = "LightCulling";
+    lightCullingPass.sideEffects    = true;
+    lightCullingPass.execute        = [this](VkCommandBuffer commandBuffer, const Pipeline::RenderInfo&) { LightCullingPass(commandBuffer); };
+    m_RenderGraph->AddPass(std::move(lightCullingPass));
+
+    // Lighting Pass, shades the G-buffer over the full screen unless the compute lighting pass does it in tiles.
+    // B10G11R11 storage is optional, so the compact HDR target always takes the full screen pass
+    if(!IsComputeLightingActive())
+    {
+        RenderGraph::PassInfo lightingPass{};
+        lightingPass.name = "Lighting";
+        for(RenderGraph::ResourceHandle handle : m_GBufferHandles)
+        {
+            lightingPass.usages.push_back({ handle, RenderGraph::Access::FragmentSampledRead, VK_ATTACHMENT_LOAD_OP_DONT_CARE, {} });
+        }
+        if(m_Info.compactGBuffer)
+        {
+            lightingPass.usages.push_back({ m_DepthHandle, RenderGraph::Access::FragmentSampledRead, VK_ATTACHMENT_LOAD_OP_DONT_CARE, {} });
+        }
+        lightingPass.usages.push_back({ m_HDRHandle, RenderGraph::Access::ColorAttachmentWrite, VK_ATTACHMENT_LOAD_OP_CLEAR, {} });
+        lightingPass.execute = [this](VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo) { LightingPass(commandBuffer, renderInfo); };
+        m_RenderGraph->AddPass(std::move(lightingPass));
+    } else
+    {
+        RenderGraph::PassInfo computeLightingPass{};
+        computeLightingPass.name = "ComputeLighting";
+        for(RenderGraph::ResourceHandle handle : m_GBufferHandles)
+        {
+            computeLightingPass.usages.push_back({ handle, RenderGraph::Access::ComputeSampledRead, VK_ATTACHMENT_LOAD_OP_DONT_CARE, {} });
+        }
+        if(m_Info.compactGBuffer)
+        {
+            computeLightingPass.usages.push_back({ m_DepthHandle, RenderGraph::Access::ComputeSampledRead, VK_ATTACHMENT_LOAD_OP_DONT_CARE, {} });
+        }
+        computeLightingPass.usages.push_back({ m_HDRHandle, RenderGraph::Access::ComputeStorageWrite, VK_ATTACHMENT_LOAD_OP_DONT_CARE, {} });
+        computeLightingPass.execute = [this](VkCommandBuffer commandBuffer, const Pipeline::RenderInfo&) { ComputeLightingPass(commandBuffer); };
+        m_RenderGraph->AddPass(std::move(computeLightingPass));
+    }
 
-    Pipeline::Attachment albedoAttachment{};
-    albedoAttachment.imageView      = m_GeometryBuffer[m_FrameIndex]->GetAttachments()[0].GetImageView();
-    albedoAttachment.imageLayout    = m_GeometryBuffer[m_FrameIndex]->GetAttachments()[0].GetImageLayout();
-    albedoAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    albedoAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
-    albedoAttachment.clearValue     = {};
-    colorAttachments.push_back(albedoAttachment);
+    // Light Volume Pass, adds the point lights onto the ambient term when light volumes replace the clusters
+    if(m_Info.lightVolumes)
+    {
+        RenderGraph::PassInfo lightVolumePass{};
+        lightVolumePass.name = "LightVolumes";
+        for(RenderGraph::ResourceHandle handle : m_GBufferHandles)
+        {
+            lightVolumePass.usages.push_back({ handle, RenderGraph::Access::FragmentSampledRead, VK_ATTACHMENT_LOAD_OP_DONT_CARE, {} });
+        }
+        lightVolumePass.usages.push_back({ m_DepthHandle, RenderGraph::Access::DepthAttachmentRead, VK_ATTACHMENT_LOAD_OP_LOAD, {} });
+        lightVolumePass.usages.push_back({ m_HDRHandle, RenderGraph::Access::ColorAttachmentWrite, VK_ATTACHMENT_LOAD_OP_LOAD, {} });
+        lightVolumePass.execute = [this](VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo) { LightVolumePass(commandBuffer, renderInfo); };
+        m_RenderGraph->AddPass(std::move(lightVolumePass));
+    }
+
+    // Tone Mapping Pass
+    RenderGraph::PassInfo tonemappingPass{};
+    tonemappingPass.name = "Tonemapping";
+    tonemappingPass.usages.push_back({ m_HDRHandle, RenderGraph::Access::FragmentSampledRead, VK_ATTACHMENT_LOAD_OP_DONT_CARE, {} });
+    tonemappingPass.usages.push_back({ m_OutputHandle, RenderGraph::Access::ColorAttachmentWrite, VK_ATTACHMENT_LOAD_OP_CLEAR, {} });
+    tonemappingPass.execute = [this](VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo) { TonemappingPass(commandBuffer, renderInfo); };
+    m_RenderGraph->AddPass(std::move(tonemappingPass));
+
+    // Offscreen targets stay as colour attachments, swapchain images go to present
+    m_RenderGraph->MarkOutput(m_OutputHandle, m_Headless ? RenderGraph::Access::None : RenderGraph::Access::Present);
+    m_RenderGraph->Compile();
+}
 
-    Pipeline::Attachment positionAttachment{};
-    positionAttachment.imageView      = m_GeometryBuffer[m_FrameIndex]->GetAttachments()[1].GetImageView();
-    positionAttachment.imageLayout    = m_GeometryBuffer[m_FrameIndex]->GetAttachments()[1].GetImageLayout();
-    positionAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    positionAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
-    positionAttachment.clearValue     = {};
-    colorAttachments.push_back(positionAttachment);
+void Renderer::BindFrameResources()
+{
+    m_RenderGraph->SetImportedImage(m_OutputHandle, m_FrameIndex, m_Headless ? m_OffscreenTargets[m_ImageIndex].get() : m_Swapchain->GetImage(m_ImageIndex));
+}
 
-    Pipeline::Attachment normalAttachment{};
-    normalAttachment.imageView      = m_GeometryBuffer[m_FrameIndex]->GetAttachments()[2].GetImageView();
-    normalAttachment.imageLayout    = m_GeometryBuffer[m_FrameIndex]->GetAttachments()[2].GetImageLayout();
-    normalAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    normalAttachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
-    normalAttachment.clearValue     = {};
-    colorAttachments.push_back(normalAttachment);
+void Renderer::CullingPass(VkCommandBuffer commandBuffer, SceneDrawList::Phase phase)
+{
+    CN_PROFILE_ZONE(phase == SceneDrawList::EarlyPhase ? "CullingPass" : "LateCullingPass");
 
-    Pipeline::Attachment depthAttachment{};
-    depthAttachment.imageView   = m_GeometryBuffer[m_FrameIndex]->GetAttachments()[3].GetImageView();
-    depthAttachment.imageLayout = m_GeometryBuffer[m_FrameIndex]->GetAttachments()[3].GetImageLayout();
-    depthAttachment.loadOp      = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    depthAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
-    depthAttachment.clearValue  = {.depthStencil{1.0f, 0}};
+    if(phase == SceneDrawList::EarlyPhase)
+    {
+        // Whatever the GPU does not cull is frustum culled on the CPU before its commands are written
+        SceneDrawList::BuildInfo buildInfo{};
+        buildInfo.cpuCulling    = m_CpuCulling && !(m_IndirectDrawing && m_GpuCulling);
+        buildInfo.frontToBack   = m_FrontToBack;
+        m_DrawList->Build(*m_Packet, m_FrameIndex, buildInfo);
+    }
 
-    Pipeline::RenderInfo renderInfo{};
-    renderInfo.colorAttachments = colorAttachments;
-    renderInfo.depthAttachment  = depthAttachment;
-    renderInfo.extent           = m_Swapchain.GetExtent();
+    uint32_t drawCount = m_DrawList->GetDrawCount();
+    bool occlusionCulling = IsOcclusionCullingActive();
+    if(!m_IndirectDrawing || !m_GpuCulling || drawCount == 0 || (phase == SceneDrawList::LatePhase && !occlusionCulling))
+    {
+        return;
+    }
 
-    m_GeometryPipeline->BeginRender(m_CommandBuffers[m_FrameIndex], renderInfo);
+    // The visibility buffer carries over from the late phase of the previous frame, and is rewritten by this frame's late phase
+    VkBufferMemoryBarrier2 visibilityBarrier{};
+    visibilityBarrier.sType                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    visibilityBarrier.srcStageMask          = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    visibilityBarrier.srcAccessMask         = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    visibilityBarrier.dstStageMask          = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    visibilityBarrier.dstAccessMask         = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    visibilityBarrier.srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+    visibilityBarrier.dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+    visibilityBarrier.buffer                = m_DrawList->GetVisibilityBuffer();
+    visibilityBarrier.offset                = 0;
+    visibilityBarrier.size                  = VK_WHOLE_SIZE;
+    if(occlusionCulling)
+    {
+        m_CullingBarriers.AddBufferBarrier(visibilityBarrier);
+        m_CullingBarriers.Flush(commandBuffer);
+    }
 
-    m_GeometryPipeline->BindDescriptorSet(m_ActiveScene->GetCamera().GetDescriptorSet(m_FrameIndex), 0U);
-    for(const auto& sceneMember : m_ActiveScene->GetSceneMembers())
+    SceneDrawList::CullingParams params{};
+    params.drawCount        = drawCount;
+    params.phase            = phase;
+    params.occlusion        = occlusionCulling ? 1U : 0U;
+    params.capacity         = m_DrawList->GetCapacity();
+    params.pyramidSize      = glm::vec2(m_DepthPyramid->GetExtent().width, m_DepthPyramid->GetExtent().height);
+    params.pyramidLevels    = m_DepthPyramid->GetMipLevels();
+
+    m_CullingPipeline->Begin(commandBuffer, phase == SceneDrawList::EarlyPhase ? "Culling" : "LateCulling");
+    m_CullingPipeline->BindDescriptorSet(m_ActiveScene->GetCamera().GetDescriptorSet(m_FrameIndex), 0U);
+    m_CullingPipeline->BindDescriptorSet(m_DrawList->GetDescriptorSet(m_FrameIndex), 1U);
+    m_CullingPipeline->BindDescriptorSet(m_DepthPyramid->GetDescriptorSet(), 2U);
+    m_CullingPipeline->PushConstant(0U, sizeof(SceneDrawList::CullingParams), &params);
+    // 64 invocations per group, see Culling.comp
+    m_CullingPipeline->Dispatch((drawCount + 63) / 64);
+    m_CullingPipeline->End();
+
+    // The compacted commands and their counts are consumed as indirect arguments by the geometry pass
+    std::array<VkBuffer, 2> indirectBuffers = { m_DrawList->GetVisibleBuffer(m_FrameIndex), m_DrawList->GetCounterBuffer(m_FrameIndex) };
+    for(VkBuffer buffer : indirectBuffers)
     {
-        m_GeometryPipeline->PushConstant(VK_SHADER_STAGE_VERTEX_BIT, 0U, sizeof(glm::mat4), &sceneMember.GetModelMatrix());
-        for(const auto& submesh : sceneMember.GetMesh()->m_SubMeshes)
+        VkBufferMemoryBarrier2 barrier{};
+        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+        barrier.srcStageMask        = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        barrier.srcAccessMask       = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+        barrier.dstStageMask        = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+        barrier.dstAccessMask       = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer              = buffer;
+        barrier.offset              = 0;
+        barrier.size                = VK_WHOLE_SIZE;
+        m_CullingBarriers.AddBufferBarrier(barrier);
+    }
+    m_CullingBarriers.Flush(commandBuffer);
+}
+
+void Renderer::DepthPyramidPass(VkCommandBuffer commandBuffer)
+{
+    CN_PROFILE_ZONE("DepthPyramidPass");
+
+    if(IsOcclusionCullingActive() && m_DrawList->GetDrawCount() != 0)
+    {
+        m_DepthPyramid->Build(commandBuffer, m_FrameIndex);
+    }
+}
+
+void Renderer::DepthPrepass(VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo)
+{
+    CN_PROFILE_FUNCTION();
+
+    // Auto frames without the pre-pass record nothing here, the geometry pass clears depth instead
+    if(!m_DepthPrepassUsed[m_FrameIndex])
+    {
+        return;
+    }
+
+    DrawGeometry(*m_DepthPrepassPipeline, commandBuffer, renderInfo, "DepthPrepass", SceneDrawList::EarlyPhase);
+}
+
+void Renderer::GeometryPass(VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo, SceneDrawList::Phase phase)
+{
+    CN_PROFILE_ZONE(phase == SceneDrawList::EarlyPhase ? "GeometryPass" : "LateGeometryPass");
+
+    // Everything not culled on the GPU is drawn by the early pass, the late pass keeps the attachments as they are
+    if(phase == SceneDrawList::LatePhase && !IsOcclusionCullingActive())
+    {
+        return;
+    }
+
+    // The pre-pass drew exactly the early draws, the late ones were hidden from it and still test with LESS
+    bool equalDepth = phase == SceneDrawList::EarlyPhase && m_DepthPrepassUsed[m_FrameIndex];
+    std::string_view scopeName = phase == SceneDrawList::EarlyPhase ? "Geometry" : "LateGeometry";
+
+    // The graph loads the pre-pass depth, on Auto frames that skipped the pre-pass there is none to load
+    if(phase == SceneDrawList::EarlyPhase && m_Info.depthPrepass != DepthPrepassMode::Off && !m_DepthPrepassUsed[m_FrameIndex])
+    {
+        Pipeline::RenderInfo clearInfo{.colorAttachments = std::pmr::vector<Pipeline::Attachment>(renderInfo.colorAttachments, &GetFrameArena()), .depthAttachment = renderInfo.depthAttachment, .extent = renderInfo.extent};
+        clearInfo.depthAttachment.loadOp        = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        clearInfo.depthAttachment.clearValue    = {.depthStencil{1.0f, 0}};
+        DrawGeometry(*m_GeometryPipeline, commandBuffer, clearInfo, scopeName, phase);
+        return;
+    }
+
+    DrawGeometry(equalDepth ? *m_GeometryEqualPipeline : *m_GeometryPipeline, commandBuffer, renderInfo, scopeName, phase);
+}
+
+void Renderer::DrawGeometry(Pipeline& pipeline, VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo, std::string_view scopeName, SceneDrawList::Phase phase)
+{
+    // Indirect drawing records one call per group, only direct drawing has enough calls to split
+    if(m_ParallelRecording && !m_IndirectDrawing && m_DrawList->GetDrawCount() >= PARALLEL_RECORDING_MIN_DRAWS)
+    {
+        ParallelGeometryPass(pipeline, commandBuffer, renderInfo, scopeName);
+        return;
+    }
+
+    pipeline.BeginRender(commandBuffer, renderInfo, scopeName);
+
+    pipeline.BindDescriptorSet(m_ActiveScene->GetCamera().GetDescriptorSet(m_FrameIndex), 0U);
+    pipeline.BindDescriptorSet(m_AssetManager->GetMaterialTable().GetDescriptorSet(), 1U);
+    pipeline.BindDescriptorSet(m_DrawList->GetDescriptorSet(m_FrameIndex), 2U);
+
+    // Geometry is bound per arena block, which is once per frame unless the scene outgrew the first block
+    const GeometryArena& geometryArena = m_AssetManager->GetGeometryArena();
+    uint32_t boundBlock = std::numeric_limits<uint32_t>::max();
+
+    const std::vector<VkDrawIndexedIndirectCommand>& commands = m_DrawList->GetCommands();
+    const std::vector<SceneDrawList::DrawGroup>& groups = m_DrawList->GetGroups();
+    for(size_t i = 0; i < groups.size(); i++)
+    {
+        const SceneDrawList::DrawGroup& group = groups[i];
+        if(group.block != boundBlock)
+        {
+            pipeline.BindGeometry(geometryArena, group.block);
+            boundBlock = group.block;
+        }
+
+        // Culled groups keep their slice of the visible buffer, only the first visibleCount commands are filled
+        if(m_IndirectDrawing && m_GpuCulling)
+        {
+            pipeline.DrawIndexedIndirectCount(m_DrawList->GetVisibleBuffer(m_FrameIndex), m_DrawList->GetVisibleOffset(phase, group.firstCommand),
+                                              m_DrawList->GetCounterBuffer(m_FrameIndex), m_DrawList->GetCounterOffset(phase, static_cast<uint32_t>(i)), group.commandCount);
+            continue;
+        }
+
+        if(m_IndirectDrawing)
+        {
+            pipeline.DrawIndexedIndirect(m_DrawList->GetIndirectBuffer(m_FrameIndex), group.firstCommand * sizeof(VkDrawIndexedIndirectCommand), group.commandCount);
+            continue;
+        }
+
+        for(uint32_t j = group.firstCommand; j < group.firstCommand + group.commandCount; j++)
         {
-            m_GeometryPipeline->PushConstant(VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(glm::mat4), sizeof(submesh.GetMaterial()->GetMaterialObject()), &submesh.GetMaterial()->GetMaterialObject());
-            m_GeometryPipeline->BindDescriptorSet(submesh.GetMaterial()->GetDescriptorSet(), 1U);
-            m_GeometryPipeline->BindVertexBuffer(submesh.GetVertexBuffer());
-            m_GeometryPipeline->BindIndexBuffer(submesh.GetIndexBuffer());
-            m_GeometryPipeline->DrawIndexed(submesh.GetIndexBuffer().GetIndicesCount());
+            pipeline.DrawIndexed(commands[j].indexCount, commands[j].firstIndex, commands[j].vertexOffset, commands[j].firstInstance);
         }
     }
 
-    m_GeometryPipeline->EndRender();
+    pipeline.EndRender();
+}
+
+void Renderer::ParallelGeometryPass(Pipeline& pipeline, VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo, std::string_view scopeName)
+{
+    CN_PROFILE_FUNCTION();
+
+    pipeline.BeginRender(commandBuffer, renderInfo, scopeName, true);
+
+    // Contiguous chunks executed in order keep the draw order of the list
+    uint32_t drawCount  = m_DrawList->GetDrawCount();
+    uint32_t chunkCount = std::min(m_JobSystem->GetThreadCount(), (drawCount + MIN_DRAWS_PER_CHUNK - 1) / MIN_DRAWS_PER_CHUNK);
+    uint32_t chunkSize  = (drawCount + chunkCount - 1) / chunkCount;
+
+    std::pmr::vector<VkCommandBuffer> chunkBuffers(chunkCount, VK_NULL_HANDLE, &GetFrameArena());
+    std::pmr::vector<CommandRecorder::Stats> chunkStats(chunkCount, CommandRecorder::Stats{}, &GetFrameArena());
+
+    // Chunk jobs never wait, so no other job can interleave on a thread and share its recorder or pool
+    m_JobSystem->ParallelFor(chunkCount, 1, [&](uint32_t chunk, uint32_t threadIndex)
+    {
+        CN_PROFILE_ZONE("RecordGeometryChunk");
+
+        CommandRecorder& recorder       = *m_ChunkRecorders[threadIndex];
+        VkCommandBuffer secondaryBuffer = m_CommandPools->AcquireSecondary(m_FrameIndex, threadIndex);
+
+        pipeline.BeginSecondary(recorder, secondaryBuffer, renderInfo.extent);
+        RecordGeometryChunk(pipeline, recorder, chunk * chunkSize, std::min(drawCount, (chunk + 1) * chunkSize));
+        pipeline.EndSecondary(recorder);
+
+        chunkBuffers[chunk] = secondaryBuffer;
+        chunkStats[chunk]   = recorder.GetStats();
+    });
+
+    pipeline.ExecuteSecondaries(chunkBuffers);
+    for(const CommandRecorder::Stats& stats : chunkStats)
+    {
+        m_CommandRecorder.AddStats(stats);
+    }
+
+    pipeline.EndRender();
 }
 
-void Renderer::LightingPass()
+void Renderer::RecordGeometryChunk(const Pipeline& pipeline, CommandRecorder& recorder, uint32_t firstCommand, uint32_t endCommand) const
 {
-    // Change HDR Image Layout
-    m_HDRImages[m_FrameIndex]->ChangeLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    pipeline.BindDescriptorSet(recorder, m_ActiveScene->GetCamera().GetDescriptorSet(m_FrameIndex), 0U);
+    pipeline.BindDescriptorSet(recorder, m_AssetManager->GetMaterialTable().GetDescriptorSet(), 1U);
+    pipeline.BindDescriptorSet(recorder, m_DrawList->GetDescriptorSet(m_FrameIndex), 2U);
 
-    // Change GBuffer Image Layouts to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-    for(size_t i = 0; i < m_GeometryBuffer[m_FrameIndex]->GetAttachments().size() - 1; i++)
+    const GeometryArena& geometryArena = m_AssetManager->GetGeometryArena();
+    const std::vector<VkDrawIndexedIndirectCommand>& commands = m_DrawList->GetCommands();
+    for(const SceneDrawList::DrawGroup& group : m_DrawList->GetGroups())
     {
-        m_GeometryBuffer[m_FrameIndex]->GetAttachments()[i].ChangeLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        uint32_t first  = std::max(firstCommand, group.firstCommand);
+        uint32_t end    = std::min(endCommand, group.firstCommand + group.commandCount);
+        if(first >= end)
+        {
+            continue;
+        }
+
+        // The recorder skips the bind when consecutive groups share a block
+        pipeline.BindGeometry(recorder, geometryArena, group.block);
+        for(uint32_t j = first; j < end; j++)
+        {
+            pipeline.DrawIndexed(recorder, commands[j].indexCount, commands[j].firstIndex, commands[j].vertexOffset, commands[j].firstInstance);
+        }
     }
+}
 
-    // Update LBO
-    UpdateLights();
+void Renderer::LightCullingPass(VkCommandBuffer commandBuffer)
+{
+    CN_PROFILE_ZONE("LightCullingPass");
 
-    Pipeline::Attachment colorAttachment{};
-    colorAttachment.imageView   = m_HDRImages[m_FrameIndex]->GetImageView();
-    colorAttachment.imageLayout = m_HDRImages[m_FrameIndex]->GetImageLayout();
-    colorAttachment.loadOp      = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    colorAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
-    colorAttachment.clearValue  = {};
+    // Light volumes and the compute lighting pass find their lights without the clusters
+    if(IsComputeLightingActive() || m_Info.lightVolumes)
+    {
+        return;
+    }
 
-    Pipeline::RenderInfo renderInfo{};
-    renderInfo.colorAttachments = { colorAttachment };
-    renderInfo.extent           = m_Swapchain.GetExtent();
+    m_LightClusters->Build(commandBuffer, m_FrameIndex);
+}
+
+void Renderer::LightingPass(VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo)
+{
+    CN_PROFILE_ZONE("LightingPass");
 
-    m_LightingPipeline->BeginRender(m_CommandBuffers[m_FrameIndex], renderInfo);
+    // With light volumes only the ambient term is shaded over the full screen
+    if(m_Info.lightVolumes)
+    {
+        m_AmbientPipeline->BeginRender(commandBuffer, renderInfo);
+        m_AmbientPipeline->BindDescriptorSet(m_GBufferDescriptorSets[m_FrameIndex]->GetDescriptorSet(), 0U);
+        m_AmbientPipeline->Draw(3);
+        m_AmbientPipeline->EndRender();
+        return;
+    }
+
+    m_LightingPipeline->BeginRender(commandBuffer, renderInfo);
     m_LightingPipeline->BindDescriptorSet(m_GBufferDescriptorSets[m_FrameIndex]->GetDescriptorSet(), 0U);
+    m_LightingPipeline->BindDescriptorSet(m_LightClusters->GetDescriptorSet(m_FrameIndex), 1U);
     m_LightingPipeline->Draw(3);
     m_LightingPipeline->EndRender();
 }
 
-void Renderer::TonemappingPass()
+void Renderer::ComputeLightingPass(VkCommandBuffer commandBuffer)
 {
-    // Change Swapchain Image Layout
-    m_Swapchain.ChangeLayout(m_ImageIndex, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, m_CommandBuffers[m_FrameIndex]);
+    CN_PROFILE_ZONE("ComputeLightingPass");
+
+    VkExtent2D extent = GetOutputExtent();
+    m_ComputeLightingPipeline->Begin(commandBuffer);
+    m_ComputeLightingPipeline->BindDescriptorSet(m_GBufferDescriptorSets[m_FrameIndex]->GetDescriptorSet(), 0U);
+    m_ComputeLightingPipeline->BindDescriptorSet(m_LightClusters->GetDescriptorSet(m_FrameIndex), 1U);
+    m_ComputeLightingPipeline->BindDescriptorSet(m_HDRStorageDescriptorSets[m_FrameIndex]->GetDescriptorSet(), 2U);
+    m_ComputeLightingPipeline->Dispatch((extent.width + LIGHTING_TILE_SIZE - 1) / LIGHTING_TILE_SIZE, (extent.height + LIGHTING_TILE_SIZE - 1) / LIGHTING_TILE_SIZE);
+    m_ComputeLightingPipeline->End();
+}
 
-    // Change HDR Layout for sampling
-    m_HDRImages[m_FrameIndex]->ChangeLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+void Renderer::LightVolumePass(VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo)
+{
+    CN_PROFILE_ZONE("LightVolumePass");
 
-    Pipeline::Attachment colorAttachment{};
-    colorAttachment.imageView   = m_Swapchain.GetImageViews()[m_ImageIndex];
-    colorAttachment.imageLayout = m_Swapchain.GetImageLayouts()[m_ImageIndex];
-    colorAttachment.loadOp      = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    colorAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
-    colorAttachment.clearValue  = {};
+    if(m_Packet->pointLights.empty())
+    {
+        return;
+    }
 
-    Pipeline::RenderInfo renderInfo{};
-    renderInfo.colorAttachments = { colorAttachment };
-    renderInfo.extent           = m_Swapchain.GetExtent();
+    m_LightVolumePipeline->BeginRender(commandBuffer, renderInfo);
+    m_LightVolumePipeline->BindDescriptorSet(m_DepthReadGBufferDescriptorSets[m_FrameIndex]->GetDescriptorSet(), 0U);
+    m_LightVolumePipeline->BindDescriptorSet(m_LightClusters->GetDescriptorSet(m_FrameIndex), 1U);
+    m_LightVolumePipeline->BindDescriptorSet(m_ActiveScene->GetCamera().GetDescriptorSet(static_cast<uint32_t>(m_FrameIndex)), 2U);
+    m_LightVolumePipeline->BindDescriptorSet(m_LightVolumeMesh->GetDescriptorSet(), 3U);
+    // One instance per light, placed from the light buffer
+    m_LightVolumePipeline->Draw(m_LightVolumeMesh->GetVertexCount(), static_cast<uint32_t>(m_Packet->pointLights.size()));
+    m_LightVolumePipeline->EndRender();
+}
+
+void Renderer::TonemappingPass(VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo)
+{
+    CN_PROFILE_ZONE("TonemappingPass");
 
-    m_TonemappingParams[m_FrameIndex].exposure = m_ActiveScene->GetCamera().GetExposure();
+    m_TonemappingParams[m_FrameIndex].exposure = m_Packet->exposure;
 
-    m_TonemappingPipeline->BeginRender(m_CommandBuffers[m_FrameIndex], renderInfo);
+    m_TonemappingPipeline->BeginRender(commandBuffer, renderInfo);
     m_TonemappingPipeline->PushConstant(VK_SHADER_STAGE_FRAGMENT_BIT, 0U, sizeof(PostProcessing::TonemappingParams), &m_TonemappingParams[m_FrameIndex]);
     m_TonemappingPipeline->BindDescriptorSet(m_HDRDescriptorSets[m_FrameIndex]->GetDescriptorSet(), 0U);
     m_TonemappingPipeline->Draw(3);
@@ -449,24 +921,79 @@ void Renderer::TonemappingPass()
 
 void Renderer::BeginFrame()
 {
-    vkWaitForFences(m_Context->GetLogicalDevice(), 1, &m_InFlightFences[m_FrameIndex], VK_TRUE, std::numeric_limits<uint64_t>::max());
-    VK_CHECK(vkAcquireNextImageKHR(m_Context->GetLogicalDevice(), m_Swapchain.GetSwapchain(), UINT64_MAX, m_ImageAvailableSems[m_FrameIndex], VK_NULL_HANDLE, &m_ImageIndex))
+    CN_PROFILE_FUNCTION();
+
+    {
+        CN_PROFILE_ZONE("WaitForFence");
+        vkWaitForFences(m_Context->GetLogicalDevice(), 1, &m_InFlightFences[m_FrameIndex], VK_TRUE, std::numeric_limits<uint64_t>::max());
+    }
+
+    if(m_Headless)
+    {
+        // Offscreen targets are owned per frame, so the fence above already made this one available
+        m_ImageIndex = static_cast<uint32_t>(m_FrameIndex);
+    } else
+    {
+        VK_CHECK(vkAcquireNextImageKHR(m_Context->GetLogicalDevice(), m_Swapchain->GetSwapchain(), UINT64_MAX, m_ImageAvailableSems[m_FrameIndex], VK_NULL_HANDLE, &m_ImageIndex))
+    }
 
     /*
      *  Handle Swapchain Recreation
      */
     vkResetFences(m_Context->GetLogicalDevice(), 1U, &m_InFlightFences[m_FrameIndex]);
-    vkResetCommandBuffer(m_CommandBuffers[m_FrameIndex], 0U);
+    m_CommandPools->Reset(m_FrameIndex);
+    GetFrameArena().Reset();
 
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
     VK_CHECK(vkBeginCommandBuffer(m_CommandBuffers[m_FrameIndex], &beginInfo))
+    m_CommandRecorder.Begin(m_CommandBuffers[m_FrameIndex]);
+
+    // Results of the frame that last used this slot are complete now that its fence signalled
+    m_GpuProfiler->BeginFrame(m_CommandBuffers[m_FrameIndex], m_FrameIndex);
+    UpdateDepthPrepass();
+}
+
+void Renderer::UpdateDepthPrepass()
+{
+    if(m_Info.depthPrepass == DepthPrepassMode::Auto)
+    {
+        // A new geometry sample means the slot's previous frame was read back, the pre-pass scope only exists on frames that used it
+        const GpuProfiler::ScopeStats* prepassStats     = m_GpuProfiler->FindStats("DepthPrepass");
+        const GpuProfiler::ScopeStats* geometryStats    = m_GpuProfiler->FindStats("Geometry");
+        const bool prepassUsed = m_DepthPrepassUsed[m_FrameIndex];
+        if(geometryStats && geometryStats->sampleCount != m_DepthPrepassSampleCount && (prepassStats || !prepassUsed))
+        {
+            double prepassMs = prepassUsed ? prepassStats->lastMs : 0.0;
+            m_DepthPrepassSelector.AddSample(prepassUsed, prepassMs + geometryStats->lastMs);
+            m_DepthPrepassSampleCount = geometryStats->sampleCount;
+        }
+    }
+
+    m_DepthPrepassUsed[m_FrameIndex] = m_Info.depthPrepass == DepthPrepassMode::On || (m_Info.depthPrepass == DepthPrepassMode::Auto && m_DepthPrepassSelector.UsePrepass());
 }
 
 void Renderer::EndFrame()
 {
-    m_Swapchain.ChangeLayout(m_ImageIndex, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_IMAGE_ASPECT_COLOR_BIT, m_CommandBuffers[m_FrameIndex]);
+    CN_PROFILE_FUNCTION();
+
+    m_GpuProfiler->EndFrame(m_CommandBuffers[m_FrameIndex]);
+
+    if(m_Headless)
+    {
+        VK_CHECK(vkEndCommandBuffer(m_CommandBuffers[m_FrameIndex]))
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = &m_CommandBuffers[m_FrameIndex];
+
+        VK_CHECK(vkQueueSubmit(m_Context->GetGraphicsQueue(), 1, &submitInfo, m_InFlightFences[m_FrameIndex]))
+        m_FrameIndex = (m_FrameIndex + 1) % Swapchain::FRAMES_IN_FLIGHT;
+        return;
+    }
+
     VK_CHECK(vkEndCommandBuffer(m_CommandBuffers[m_FrameIndex]))
 
     VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT  };
@@ -483,7 +1010,7 @@ void Renderer::EndFrame()
 
     VK_CHECK(vkQueueSubmit(m_Context->GetGraphicsQueue(), 1, &submitInfo, m_InFlightFences[m_FrameIndex]))
 
-    VkSwapchainKHR swapchain[] = { m_Swapchain.GetSwapchain() };
+    VkSwapchainKHR swapchain[] = { m_Swapchain->GetSwapchain() };
 
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -493,27 +1020,40 @@ void Renderer::EndFrame()
     presentInfo.pSwapchains         = swapchain;
     presentInfo.pImageIndices       = &m_ImageIndex;
 
+    CN_PROFILE_ZONE("Present");
     VK_CHECK(vkQueuePresentKHR(m_Context->GetPresentQueue(), &presentInfo))
     m_FrameIndex = (m_FrameIndex + 1) % Swapchain::FRAMES_IN_FLIGHT;
 }
 
-void Renderer::DrawFrame()
+void Renderer::DrawFrame(const RenderPacket& packet)
 {
+    CN_PROFILE_FUNCTION();
+
+    m_Packet = &packet;
+
     BeginFrame();
-    GeometryPass();
-    LightingPass();
-    TonemappingPass();
+    // The slot's fence signalled, so its uniform buffers are no longer read
+    m_ActiveScene->GetCamera().WriteBuffer(static_cast<uint32_t>(m_FrameIndex), packet.camera);
+    m_LightClusters->Update(packet, m_FrameIndex);
+    BindFrameResources();
+    {
+        CN_PROFILE_ZONE("RecordRenderGraph");
+        m_RenderGraph->Execute(m_CommandBuffers[m_FrameIndex], m_FrameIndex, &GetFrameArena());
+    }
     EndFrame();
+
+    m_Packet = nullptr;
 }
 
 Renderer::~Renderer()
 {
     vkDeviceWaitIdle(m_Context->GetLogicalDevice());
 
-    if(!m_CommandBuffers.empty())
+    if(m_AttachmentSampler)
     {
-        vkFreeCommandBuffers(m_Context->GetLogicalDevice(), m_Context->GetCommandPool(), m_CommandBuffers.size(), m_CommandBuffers.data());
+        vkDestroySampler(m_Context->GetLogicalDevice(), m_AttachmentSampler, nullptr);
     }
+
     if(!m_InFlightFences.empty())
     {
         for(VkFence fence : m_InFlightFences)
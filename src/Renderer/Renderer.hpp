@@ -1,73 +1,217 @@
 #pragma once
 
 #include "Swapchain.hpp"
+#include "RenderGraph.hpp"
+#include "GpuProfiler.hpp"
+#include "SceneDrawList.hpp"
+#include "DepthPyramid.hpp"
+#include "DepthPrepassSelector.hpp"
+#include "LightClusters.hpp"
+#include "LightVolumeMesh.hpp"
 #include "Pipeline.hpp"
-#include "Framebuffer.hpp"
+#include "ComputePipeline.hpp"
+#include "BarrierBatch.hpp"
+#include "CommandRecorder.hpp"
+#include "FrameCommandPools.hpp"
+#include "RenderPacket.hpp"
+#include "Image.hpp"
+#include "Core/LinearAllocator.hpp"
 #include "DescriptorSet.hpp"
-#include "Buffer/VertexBuffer.hpp"
-#include "Buffer/IndexBuffer.hpp"
+#include "Buffer/GeometryArena.hpp"
 #include "Scene/Lights.hpp"
 #include "Scene/PostProcessing/Tonemapping.hpp"
 
 class Context;
 class Scene;
+class AssetManager;
+class JobSystem;
 
 class Renderer
 {
 public:
-    Renderer(Context* context, Scene* scene);
+    // Auto measures both modes on the GPU and keeps the cheaper one, it stays off without timestamp queries
+    enum class DepthPrepassMode
+    {
+        Off,
+        On,
+        Auto
+    };
+    // Fixed for the renderer's lifetime, the render graph's passes and images and the pipelines are built from it
+    struct RendererInfo
+    {
+        // Albedo and an octahedral normal packed with the material terms, position is reconstructed from depth
+        bool    compactGBuffer{false};
+        // B10G11R11 instead of RGBA16F, leaves out the compute lighting pass which stores RGBA16F
+        bool    compactHDR{false};
+        // Draws every point light as a sphere over an ambient pass instead of shading the light clusters over the full screen
+        bool    lightVolumes{false};
+        // Shades the G-buffer in a compute pass that culls the lights per screen tile, light volumes take precedence.
+        // Has no effect with the compact HDR target
+        bool    computeLighting{false};
+        // Lays down depth with a position only pipeline first, so the early geometry pass shades every pixel once with EQUAL.
+        // Off leaves the pre-pass out of the render graph
+        DepthPrepassMode    depthPrepass{DepthPrepassMode::Off};
+    };
+public:
+    Renderer(Context* context, AssetManager* assetManager, Scene* scene, JobSystem* jobSystem, const RendererInfo& info);
     ~Renderer();
 
     Renderer(const Renderer& otherRenderer) = delete;
     Renderer& operator=(const Renderer& otherRenderer) = delete;
 public:
-    void DrawFrame();
+    // Records and submits a frame from the packet alone, the scene may change meanwhile.
+    // Has to be called from one thread only, which may differ from the one that created the renderer
+    void DrawFrame(const RenderPacket& packet);
 public:
     inline void SetActiveScene(Scene* scene) { m_ActiveScene = scene; }
+    // Indirect submits the geometry pass as one draw call per material, direct issues one per submesh
+    inline void SetIndirectDrawing(bool indirectDrawing) { m_IndirectDrawing = indirectDrawing; }
+    // Frustum culls the indirect draws in a compute pass, direct drawing is never culled
+    inline void SetGpuCulling(bool gpuCulling) { m_GpuCulling = gpuCulling; }
+    // Two phase occlusion culling against a depth pyramid, on top of GPU frustum culling
+    inline void SetOcclusionCulling(bool occlusionCulling) { m_OcclusionCulling = occlusionCulling; }
+    // SIMD frustum culling on the CPU, for direct draws and indirect draws without GPU culling
+    inline void SetCpuCulling(bool cpuCulling) { m_CpuCulling = cpuCulling; }
+    // Orders the draws of each geometry block front to back for early depth rejection, by material otherwise
+    inline void SetFrontToBack(bool frontToBack) { m_FrontToBack = frontToBack; }
+    // Splits large direct geometry passes into secondary command buffers recorded on worker threads
+    inline void SetParallelRecording(bool parallelRecording) { m_ParallelRecording = parallelRecording; }
+    inline const SceneDrawList::CullingStats& GetCullingStats() const { return m_DrawList->GetCullingStats(); }
     inline uint32_t GetCurrentFrame() const { return m_FrameIndex; }
+    inline const RenderGraph& GetRenderGraph() const { return *m_RenderGraph; }
+    inline const GpuProfiler& GetGpuProfiler() const { return *m_GpuProfiler; }
+    // Issued and elided state changes of the frame recorded last
+    inline const CommandRecorder::Stats& GetCommandStats() const { return m_CommandRecorder.GetStats(); }
+    inline const Image* GetOffscreenTarget(size_t frameIndex) const { return m_OffscreenTargets[frameIndex].get(); }
+    VkExtent2D GetOutputExtent() const;
+    VkFormat GetOutputFormat() const;
 private:
     void Init();
     void CreateCommandBuffers();
     void CreateSyncResources();
+    void CreateOffscreenTargets();
+    // Only the thread recording the frame allocates from it, chunk jobs write into what it allocated up front
+    inline LinearAllocator& GetFrameArena() { return m_FrameArenas[m_FrameIndex]; }
 private:
-    void CreateGeometryPassResources();
+    void CreateAttachmentSampler();
     void CreateGeometryPipeline();
+    void CreateDepthPrepassPipeline();
+    void CreateCullingPipeline();
+    inline bool IsOcclusionCullingActive() const { return m_IndirectDrawing && m_GpuCulling && m_OcclusionCulling; }
 private:
-    void CreateLightObjects();
-    void CreateLightBuffers();
-    void UpdateLights();
     void CreateLightingPassResources();
+    // Binding 1 is the position target, or depth in depthLayout with the compact G-buffer
+    std::unique_ptr<DescriptorSet> CreateGBufferDescriptorSet(size_t frameIndex, VkImageLayout depthLayout) const;
     void CreateLightingPipeline();
+    void CreateLightVolumePipelines();
+    inline bool IsComputeLightingActive() const { return m_Info.computeLighting && !m_Info.lightVolumes && !m_Info.compactHDR; }
 private:
     void CreateTonemappingPassResources();
     void CreateTonemappingPipeline();
+private:
+    void CreateRenderGraph();
+    void BindFrameResources();
 private:
     void BeginFrame();
     void EndFrame();
-    void GeometryPass();
-    void LightingPass();
-    void TonemappingPass();
+    // Feeds the timings of the frame the slot recorded last to the selector and picks the mode of the next one
+    void UpdateDepthPrepass();
+    void CullingPass(VkCommandBuffer commandBuffer, SceneDrawList::Phase phase);
+    void DepthPrepass(VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo);
+    void GeometryPass(VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo, SceneDrawList::Phase phase);
+    // Draws the phase's geometry with either the depth pre-pass or one of the G-buffer pipelines
+    void DrawGeometry(Pipeline& pipeline, VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo, std::string_view scopeName, SceneDrawList::Phase phase);
+    void ParallelGeometryPass(Pipeline& pipeline, VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo, std::string_view scopeName);
+    void RecordGeometryChunk(const Pipeline& pipeline, CommandRecorder& recorder, uint32_t firstCommand, uint32_t endCommand) const;
+    void DepthPyramidPass(VkCommandBuffer commandBuffer);
+    void LightCullingPass(VkCommandBuffer commandBuffer);
+    void LightingPass(VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo);
+    void ComputeLightingPass(VkCommandBuffer commandBuffer);
+    void LightVolumePass(VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo);
+    void TonemappingPass(VkCommandBuffer commandBuffer, const Pipeline::RenderInfo& renderInfo);
 private:
     Context*                                                    m_Context;
+    AssetManager*                                               m_AssetManager;
+    // Only the camera's GPU resources are used while recording, everything else comes from the packet
     Scene*                                                      m_ActiveScene;
-    Swapchain                                                   m_Swapchain;
+    const RenderPacket*                                         m_Packet;
+    JobSystem*                                                  m_JobSystem;
+    RendererInfo                                                m_Info;
+    std::unique_ptr<Swapchain>                                  m_Swapchain;
     std::array<VkCommandBuffer, Swapchain::FRAMES_IN_FLIGHT>    m_CommandBuffers;
     std::array<VkFence, Swapchain::FRAMES_IN_FLIGHT>            m_InFlightFences;
     std::array<VkSemaphore, Swapchain::FRAMES_IN_FLIGHT>        m_ImageAvailableSems;
     std::array<VkSemaphore, Swapchain::FRAMES_IN_FLIGHT>        m_PresentSems;
     uint32_t                                                    m_ImageIndex;
     size_t                                                      m_FrameIndex;
+    bool                                                        m_Headless;
+    std::unique_ptr<GpuProfiler>                                m_GpuProfiler;
+    CommandRecorder                                             m_CommandRecorder;
+    std::unique_ptr<FrameCommandPools>                          m_CommandPools;
+private:
+    // Transient CPU data of a frame, reset wholesale once the frame's fence signalled
+    std::array<LinearAllocator, Swapchain::FRAMES_IN_FLIGHT>    m_FrameArenas;
+private:
+    // Render Graph
+    std::unique_ptr<RenderGraph>                                m_RenderGraph;
+    // Colour targets of the G-buffer, albedo first and normal last
+    std::vector<RenderGraph::ResourceHandle>                    m_GBufferHandles;
+    RenderGraph::ResourceHandle                                 m_DepthHandle;
+    RenderGraph::ResourceHandle                                 m_HDRHandle;
+    RenderGraph::ResourceHandle                                 m_OutputHandle;
+private:
+    // Headless Output Resources
+    std::array<std::unique_ptr<Image>, Swapchain::FRAMES_IN_FLIGHT>         m_OffscreenTargets;
 private:
     // Geometry Pass Resources
     std::unique_ptr<Pipeline>                                               m_GeometryPipeline;
-    std::array<std::unique_ptr<Framebuffer>, Swapchain::FRAMES_IN_FLIGHT>   m_GeometryBuffer;
+    std::unique_ptr<SceneDrawList>                                          m_DrawList;
+    bool                                                                    m_IndirectDrawing;
+    bool                                                                    m_FrontToBack;
+    VkSampler                                                               m_AttachmentSampler;
+private:
+    // Depth Pre-Pass Resources
+    std::unique_ptr<Pipeline>                                               m_DepthPrepassPipeline;
+    // The G-buffer pipeline with EQUAL and no depth writes, for the early pass after the pre-pass
+    std::unique_ptr<Pipeline>                                               m_GeometryEqualPipeline;
+    DepthPrepassSelector                                                    m_DepthPrepassSelector;
+    // Mode each slot's frame was recorded with, its timings are read back when the slot comes around again
+    std::array<bool, Swapchain::FRAMES_IN_FLIGHT>                           m_DepthPrepassUsed;
+    uint32_t                                                                m_DepthPrepassSampleCount;
+private:
+    // Parallel Geometry Recording Resources
+    // One recorder per job system thread, the stats of every chunk are folded into m_CommandRecorder afterwards
+    std::vector<std::unique_ptr<CommandRecorder>>                           m_ChunkRecorders;
+    bool                                                                    m_ParallelRecording;
+    // Below this many draws a single thread records faster than the chunks can be handed out
+    inline static constexpr uint32_t PARALLEL_RECORDING_MIN_DRAWS  = 512;
+    inline static constexpr uint32_t MIN_DRAWS_PER_CHUNK           = 128;
+private:
+    // Culling Pass Resources
+    std::unique_ptr<ComputePipeline>                                        m_CullingPipeline;
+    BarrierBatch                                                            m_CullingBarriers;
+    std::unique_ptr<DepthPyramid>                                           m_DepthPyramid;
+    bool                                                                    m_GpuCulling;
+    bool                                                                    m_OcclusionCulling;
+    bool                                                                    m_CpuCulling;
 private:
     // Lighting Pass Resources
     std::unique_ptr<Pipeline>                                               m_LightingPipeline;
     std::array<std::unique_ptr<DescriptorSet>, Swapchain::FRAMES_IN_FLIGHT> m_GBufferDescriptorSets;
-    std::array<std::unique_ptr<Image>, Swapchain::FRAMES_IN_FLIGHT>         m_HDRImages;
-    std::array<Lights::LightBufferObject, Swapchain::FRAMES_IN_FLIGHT>      m_LightsObjects;
-    std::array<std::unique_ptr<Buffer>, Swapchain::FRAMES_IN_FLIGHT>        m_LightsBuffers;
+    std::unique_ptr<LightClusters>                                          m_LightClusters;
+private:
+    // Compute Lighting Pass Resources
+    std::unique_ptr<ComputePipeline>                                        m_ComputeLightingPipeline;
+    std::array<std::unique_ptr<DescriptorSet>, Swapchain::FRAMES_IN_FLIGHT> m_HDRStorageDescriptorSets;
+    // Has to match TILE_SIZE in ComputeLighting.comp
+    inline static constexpr uint32_t LIGHTING_TILE_SIZE = 16;
+private:
+    // Light Volume Pass Resources
+    std::unique_ptr<Pipeline>                                               m_AmbientPipeline;
+    std::unique_ptr<Pipeline>                                               m_LightVolumePipeline;
+    std::unique_ptr<LightVolumeMesh>                                        m_LightVolumeMesh;
+    // Samples depth while it is bound as the read only depth attachment
+    std::array<std::unique_ptr<DescriptorSet>, Swapchain::FRAMES_IN_FLIGHT> m_DepthReadGBufferDescriptorSets;
 private:
     // Tone Mapping Pass Resources
     std::unique_ptr<Pipeline>                                                   m_TonemappingPipeline;
@@ -0,0 +1,243 @@
+#include "Core/CnPch.hpp"
+#include "SceneDrawList.hpp"
+
+#include "Context.hpp"
+#include "RenderPacket.hpp"
+
+SceneDrawList::SceneDrawList(Context* context)
+    :   m_Context{context}, m_Capacity{0}, m_CullingStats{}
+{
+    CreateResources(INITIAL_CAPACITY);
+}
+
+void SceneDrawList::CreateResources(uint32_t capacity)
+{
+    m_Capacity = capacity;
+
+    // Starts out with nothing visible, so the first late phase decides for every draw
+    Buffer::BufferInfo visibilityInfo{};
+    visibilityInfo.size             = static_cast<VkDeviceSize>(capacity) * sizeof(uint32_t);
+    visibilityInfo.usageFlags       = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    visibilityInfo.vmaMemoryUsage   = VMA_MEMORY_USAGE_AUTO;
+    visibilityInfo.vmaAllocFlags    = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    m_VisibilityBuffer = std::make_unique<Buffer>(m_Context, visibilityInfo);
+
+    std::vector<uint32_t> visibility(capacity, 0);
+    m_VisibilityBuffer->Map(visibility.data(), visibility.size() * sizeof(uint32_t));
+
+    for(size_t i = 0; i < m_Frames.size(); i++)
+    {
+        CreateFrameResources(i);
+    }
+}
+
+void SceneDrawList::CreateFrameResources(size_t frameIndex)
+{
+    FrameResources& frame = m_Frames[frameIndex];
+    VkDeviceSize capacity = m_Capacity;
+
+    Buffer::BufferInfo drawDataInfo{};
+    drawDataInfo.size           = capacity * sizeof(DrawData);
+    drawDataInfo.usageFlags     = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    drawDataInfo.vmaMemoryUsage = VMA_MEMORY_USAGE_AUTO;
+    drawDataInfo.vmaAllocFlags  = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    Buffer::BufferInfo indirectInfo{};
+    indirectInfo.size           = capacity * sizeof(VkDrawIndexedIndirectCommand);
+    indirectInfo.usageFlags     = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    indirectInfo.vmaMemoryUsage = VMA_MEMORY_USAGE_AUTO;
+    indirectInfo.vmaAllocFlags  = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    // Only ever written by the culling pass
+    Buffer::BufferInfo visibleInfo{};
+    visibleInfo.size            = PhaseCount * capacity * sizeof(VkDrawIndexedIndirectCommand);
+    visibleInfo.usageFlags      = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    visibleInfo.vmaMemoryUsage  = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+    visibleInfo.vmaAllocFlags   = 0;
+
+    // Reset from the host every frame, there are never more groups than draws
+    Buffer::BufferInfo counterInfo{};
+    counterInfo.size            = PhaseCount * capacity * sizeof(GroupCounter);
+    counterInfo.usageFlags      = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    counterInfo.vmaMemoryUsage  = VMA_MEMORY_USAGE_AUTO;
+    counterInfo.vmaAllocFlags   = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    // Read back once the frame slot comes around again
+    Buffer::BufferInfo statsInfo{};
+    statsInfo.size              = sizeof(CullingStats);
+    statsInfo.usageFlags        = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    statsInfo.vmaMemoryUsage    = VMA_MEMORY_USAGE_AUTO;
+    statsInfo.vmaAllocFlags     = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    frame.drawDataBuffer    = std::make_unique<Buffer>(m_Context, drawDataInfo);
+    frame.indirectBuffer    = std::make_unique<Buffer>(m_Context, indirectInfo);
+    frame.visibleBuffer     = std::make_unique<Buffer>(m_Context, visibleInfo);
+    frame.counterBuffer     = std::make_unique<Buffer>(m_Context, counterInfo);
+    frame.statsBuffer       = std::make_unique<Buffer>(m_Context, statsInfo);
+
+    CullingStats emptyStats{};
+    frame.statsBuffer->Map(&emptyStats, sizeof(CullingStats));
+
+    std::array<Buffer*, 6> buffers =
+            {
+                frame.drawDataBuffer.get(),
+                frame.indirectBuffer.get(),
+                frame.visibleBuffer.get(),
+                frame.counterBuffer.get(),
+                frame.statsBuffer.get(),
+                m_VisibilityBuffer.get()
+            };
+    std::array<VkDescriptorBufferInfo, 6> bufferInfos{};
+    std::vector<DescriptorSet::BindingInfo> bindings;
+
+    for(size_t i = 0; i < buffers.size(); i++)
+    {
+        bufferInfos[i].buffer   = buffers[i]->GetBuffer();
+        bufferInfos[i].offset   = 0;
+        bufferInfos[i].range    = VK_WHOLE_SIZE;
+
+        // The geometry pass only reads the draw data, the rest is for the culling pass
+        DescriptorSet::BindingInfo bindingInfo{};
+        bindingInfo.type        = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindingInfo.binding     = static_cast<uint32_t>(i);
+        bindingInfo.stageFlags  = i == 0 ? VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT : VK_SHADER_STAGE_COMPUTE_BIT;
+        bindingInfo.bufferInfo  = &bufferInfos[i];
+        bindings.push_back(bindingInfo);
+    }
+
+    frame.descriptorSet = std::make_unique<DescriptorSet>(m_Context, bindings);
+}
+
+void SceneDrawList::Build(const RenderPacket& packet, size_t frameIndex, const BuildInfo& buildInfo)
+{
+    CN_PROFILE_FUNCTION();
+
+    // The slot's fence was waited on, so its counters are complete
+    m_Frames[frameIndex].statsBuffer->Read(&m_CullingStats, sizeof(CullingStats));
+
+    m_PendingDraws.clear();
+    m_FrustumCuller.Clear();
+    for(const RenderPacket::DrawItem& item : packet.draws)
+    {
+        const GeometryArena::Range& geometry = item.geometry;
+
+        // Squared distance to the submesh's world space center, only the order matters
+        float depth = 0.0f;
+        if(buildInfo.frontToBack)
+        {
+            glm::vec3 offset = item.worldBounds.sphere.center - packet.cameraPosition;
+            depth = glm::dot(offset, offset);
+        }
+
+        // Every draw goes through the one geometry pipeline so far
+        PendingDraw draw{};
+        draw.sortKey                    = RenderQueue::MakeKey(0, geometry.block, item.materialIndex, depth);
+        draw.drawData.model             = item.model;
+        draw.drawData.boundsCenter      = item.localBounds.GetCenter();
+        draw.drawData.materialIndex     = item.materialIndex;
+        draw.drawData.boundsExtent      = item.localBounds.GetExtent();
+        draw.drawData.visibilityIndex   = static_cast<uint32_t>(m_PendingDraws.size());
+        draw.command.indexCount         = geometry.indexCount;
+        draw.command.instanceCount      = 1;
+        draw.command.firstIndex         = geometry.firstIndex;
+        draw.command.vertexOffset       = geometry.vertexOffset;
+        m_PendingDraws.push_back(draw);
+
+        if(buildInfo.cpuCulling)
+        {
+            m_FrustumCuller.Add(item.worldBounds.aabb);
+        }
+    }
+
+    CullingStats stats{};
+    stats.drawCount = static_cast<uint32_t>(m_PendingDraws.size());
+    for(const PendingDraw& draw : m_PendingDraws)
+    {
+        stats.triangleCount += draw.command.indexCount / 3;
+    }
+
+    if(buildInfo.cpuCulling)
+    {
+        m_FrustumCuller.Cull(packet.camera.viewProjectionMatrix, m_VisibleDraws);
+
+        // Visible indices ascend, so compacting in place never overwrites a draw that is still to be read
+        uint32_t visibleTriangles = 0;
+        for(size_t i = 0; i < m_VisibleDraws.size(); i++)
+        {
+            m_PendingDraws[i] = m_PendingDraws[m_VisibleDraws[i]];
+            visibleTriangles += m_PendingDraws[i].command.indexCount / 3;
+        }
+        m_PendingDraws.resize(m_VisibleDraws.size());
+
+        stats.frustumCulledDraws     = stats.drawCount - static_cast<uint32_t>(m_VisibleDraws.size());
+        stats.frustumCulledTriangles = stats.triangleCount - visibleTriangles;
+    }
+
+    // Materials are bindless so only the block splits groups, sorting by material otherwise keeps texture access coherent.
+    // The sort is stable so equal keys keep scene order and a still camera gets the same output every frame
+    m_RenderQueue.Clear();
+    for(size_t i = 0; i < m_PendingDraws.size(); i++)
+    {
+        m_RenderQueue.Push(m_PendingDraws[i].sortKey, static_cast<uint32_t>(i));
+    }
+    m_RenderQueue.Sort();
+
+    m_DrawData.clear();
+    m_Commands.clear();
+    m_Groups.clear();
+    for(const RenderQueue::Item& item : m_RenderQueue.GetItems())
+    {
+        const PendingDraw& draw = m_PendingDraws[item.payload];
+        uint32_t commandIndex = static_cast<uint32_t>(m_Commands.size());
+        uint32_t block = RenderQueue::GetBlock(item.key);
+        if(m_Groups.empty() || m_Groups.back().block != block)
+        {
+            m_Groups.push_back({ block, commandIndex, 0 });
+        }
+        m_Groups.back().commandCount++;
+
+        // firstInstance carries the draw index into gl_InstanceIndex, compaction keeps it
+        VkDrawIndexedIndirectCommand command = draw.command;
+        command.firstInstance = commandIndex;
+
+        DrawData drawData = draw.drawData;
+        drawData.groupIndex = static_cast<uint32_t>(m_Groups.size() - 1);
+
+        m_DrawData.push_back(drawData);
+        m_Commands.push_back(command);
+    }
+
+    uint32_t drawCount = static_cast<uint32_t>(m_Commands.size());
+    if(drawCount > m_Capacity)
+    {
+        uint32_t capacity = m_Capacity;
+        while(capacity < drawCount)
+        {
+            capacity *= 2;
+        }
+
+        // The visibility buffer is shared with the other frames in flight, growing is rare enough to simply wait for them
+        vkDeviceWaitIdle(m_Context->GetLogicalDevice());
+        CreateResources(capacity);
+    }
+
+    m_Frames[frameIndex].statsBuffer->Map(&stats, sizeof(CullingStats));
+
+    if(drawCount != 0)
+    {
+        m_Frames[frameIndex].drawDataBuffer->Map(m_DrawData.data(), m_DrawData.size() * sizeof(DrawData));
+        m_Frames[frameIndex].indirectBuffer->Map(m_Commands.data(), m_Commands.size() * sizeof(VkDrawIndexedIndirectCommand));
+
+        // Every phase compacts into its own slice of the visible buffer
+        for(uint32_t phase = 0; phase < PhaseCount; phase++)
+        {
+            m_Counters.clear();
+            for(const DrawGroup& group : m_Groups)
+            {
+                m_Counters.push_back({ 0, phase * m_Capacity + group.firstCommand });
+            }
+            m_Frames[frameIndex].counterBuffer->Map(m_Counters.data(), m_Counters.size() * sizeof(GroupCounter), GetCounterOffset(static_cast<Phase>(phase), 0));
+        }
+    }
+}
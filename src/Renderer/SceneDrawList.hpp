@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Swapchain.hpp"
+#include "DescriptorSet.hpp"
+#include "FrustumCuller.hpp"
+#include "RenderQueue.hpp"
+#include "Buffer/Buffer.hpp"
+
+#include "glm/glm.hpp"
+
+class Context;
+struct RenderPacket;
+
+// Flattens every submesh of a render packet into per draw data and indexed indirect commands, grouped by
+// geometry block so the geometry pass needs one indirect call per group.
+// Culling.comp compacts the commands of each group that pass the frustum test into the visible buffer,
+// counting them in the group's counter which the geometry pass reads as its draw count.
+// With occlusion culling this happens twice a frame: the early phase redraws what was visible last frame,
+// the late phase tests everything against the depth pyramid of the early phase and draws what it missed.
+class SceneDrawList
+{
+public:
+    // Matches DrawData in Geometry.vert and Culling.comp (std430), indexed with gl_InstanceIndex
+    struct DrawData
+    {
+        glm::mat4   model;
+        // Model space bounding box
+        glm::vec3   boundsCenter;
+        uint32_t    materialIndex;
+        glm::vec3   boundsExtent;
+        uint32_t    groupIndex;
+        // Scene order index, stays put while the sort order changes with the camera
+        uint32_t    visibilityIndex;
+        uint32_t    padding[3];
+    };
+    // The draw buffer is indexed with the std430 array stride of DrawData
+    static_assert(sizeof(DrawData) == 112, "DrawData has to match the std430 layout in Geometry.vert and Culling.comp");
+    struct DrawGroup
+    {
+        uint32_t    block;
+        uint32_t    firstCommand;
+        uint32_t    commandCount;
+    };
+    // Matches DrawGroup in Culling.comp, visibleCount is the count buffer entry of the group
+    struct GroupCounter
+    {
+        uint32_t    visibleCount;
+        uint32_t    firstCommand;
+    };
+    // Matches CullingStats in Culling.comp, the totals are written when the list is built
+    struct CullingStats
+    {
+        uint32_t    drawCount;
+        uint32_t    triangleCount;
+        uint32_t    frustumCulledDraws;
+        uint32_t    frustumCulledTriangles;
+        uint32_t    occlusionCulledDraws;
+        uint32_t    occlusionCulledTriangles;
+    };
+    // Matches CullingParams in Culling.comp
+    struct CullingParams
+    {
+        uint32_t    drawCount;
+        uint32_t    phase;
+        uint32_t    occlusion;
+        uint32_t    capacity;
+        glm::vec2   pyramidSize;
+        uint32_t    pyramidLevels;
+        uint32_t    padding;
+    };
+    struct BuildInfo
+    {
+        // Drops the submeshes outside the camera frustum before any command is written
+        bool        cpuCulling;
+        // Sorts the draws of each geometry block by view distance instead of by material
+        bool        frontToBack;
+    };
+    enum Phase : uint32_t
+    {
+        EarlyPhase  = 0,
+        LatePhase   = 1,
+        PhaseCount  = 2
+    };
+public:
+    explicit SceneDrawList(Context* context);
+    ~SceneDrawList() = default;
+
+    SceneDrawList(const SceneDrawList& otherDrawList) = delete;
+    SceneDrawList& operator=(const SceneDrawList& otherDrawList) = delete;
+public:
+    // Rewrites the buffers of this frame slot, its previous submission has to be complete
+    void Build(const RenderPacket& packet, size_t frameIndex, const BuildInfo& buildInfo);
+public:
+    inline const std::vector<DrawGroup>& GetGroups() const { return m_Groups; }
+    inline const std::vector<VkDrawIndexedIndirectCommand>& GetCommands() const { return m_Commands; }
+    inline uint32_t GetDrawCount() const { return static_cast<uint32_t>(m_Commands.size()); }
+    inline uint32_t GetCapacity() const { return m_Capacity; }
+    // Counters of the last completed frame, they trail the recorded frame by the frames in flight
+    inline const CullingStats& GetCullingStats() const { return m_CullingStats; }
+    inline VkBuffer GetIndirectBuffer(size_t frameIndex) const { return m_Frames[frameIndex].indirectBuffer->GetBuffer(); }
+    inline VkBuffer GetVisibleBuffer(size_t frameIndex) const { return m_Frames[frameIndex].visibleBuffer->GetBuffer(); }
+    inline VkBuffer GetCounterBuffer(size_t frameIndex) const { return m_Frames[frameIndex].counterBuffer->GetBuffer(); }
+    inline VkBuffer GetVisibilityBuffer() const { return m_VisibilityBuffer->GetBuffer(); }
+    // Every phase has its own capacity sized slice of the visible and counter buffers
+    inline VkDeviceSize GetVisibleOffset(Phase phase, uint32_t command) const { return (static_cast<VkDeviceSize>(phase) * m_Capacity + command) * sizeof(VkDrawIndexedIndirectCommand); }
+    inline VkDeviceSize GetCounterOffset(Phase phase, uint32_t group) const { return (static_cast<VkDeviceSize>(phase) * m_Capacity + group) * sizeof(GroupCounter); }
+    inline VkDescriptorSet GetDescriptorSet(size_t frameIndex) const { return m_Frames[frameIndex].descriptorSet->GetDescriptorSet(); }
+    inline VkDescriptorSetLayout GetDescriptorSetLayout() const { return m_Frames[0].descriptorSet->GetDescriptorSetLayout(); }
+    inline static constexpr uint32_t INITIAL_CAPACITY = 1024;
+private:
+    struct FrameResources
+    {
+        std::unique_ptr<Buffer>         drawDataBuffer;
+        std::unique_ptr<Buffer>         indirectBuffer;
+        std::unique_ptr<Buffer>         visibleBuffer;
+        std::unique_ptr<Buffer>         counterBuffer;
+        std::unique_ptr<Buffer>         statsBuffer;
+        std::unique_ptr<DescriptorSet>  descriptorSet;
+    };
+    struct PendingDraw
+    {
+        uint64_t                        sortKey;
+        DrawData                        drawData;
+        VkDrawIndexedIndirectCommand    command;
+    };
+private:
+    void CreateResources(uint32_t capacity);
+    void CreateFrameResources(size_t frameIndex);
+private:
+    Context*                                                m_Context;
+    uint32_t                                                m_Capacity;
+    // Last frame's visibility per draw, shared by the frames in flight since they execute in order
+    std::unique_ptr<Buffer>                                 m_VisibilityBuffer;
+    std::array<FrameResources, Swapchain::FRAMES_IN_FLIGHT> m_Frames;
+    std::vector<PendingDraw>                                m_PendingDraws;
+    RenderQueue                                             m_RenderQueue;
+    FrustumCuller                                           m_FrustumCuller;
+    std::vector<uint32_t>                                   m_VisibleDraws;
+    std::vector<DrawData>                                   m_DrawData;
+    std::vector<VkDrawIndexedIndirectCommand>               m_Commands;
+    std::vector<DrawGroup>                                  m_Groups;
+    std::vector<GroupCounter>                               m_Counters;
+    CullingStats                                            m_CullingStats;
+};
@@ -2,6 +2,7 @@
 #include "Swapchain.hpp"
 
 #include "Context.hpp"
+#include "Image.hpp"
 
 Swapchain::Swapchain(Context* context)
         : m_Context{context}, m_Swapchain{}, m_ImageFormat{}, m_Extent{}
@@ -26,7 +27,20 @@ void Swapchain::Init()
     m_Extent        = vkbSwapchain.extent;
     m_Images        = vkbSwapchain.get_images().value();
     m_ImageViews    = vkbSwapchain.get_image_views().value();
-    m_ImageLayouts.resize(m_ImageViews.size(), VK_IMAGE_LAYOUT_UNDEFINED);
+
+    for(size_t i = 0; i < m_Images.size(); i++)
+    {
+        Image::ExternalImageInfo targetInfo{};
+        targetInfo.image        = m_Images[i];
+        targetInfo.imageView    = m_ImageViews[i];
+        targetInfo.format       = m_ImageFormat;
+        targetInfo.dimension    = m_Extent;
+        targetInfo.aspectFlags  = VK_IMAGE_ASPECT_COLOR_BIT;
+        // The first transition of every image has to wait for the image available semaphore at colour output
+        targetInfo.initialState = { VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE };
+
+        m_ImageTargets.push_back(std::make_unique<Image>(m_Context, targetInfo));
+    }
 }
 
 Swapchain::SwapchainSupportDetails Swapchain::QuerySwapchainSupport()
@@ -56,21 +70,11 @@ Swapchain::SwapchainSupportDetails Swapchain::QuerySwapchainSupport()
     return details;
 }
 
-void Swapchain::ChangeLayout(size_t imageIndex, VkImageLayout newLayout, VkImageAspectFlags aspectFlags, VkCommandBuffer commandBuffer)
-{
-    Utilities::LayoutTransitionInfo layoutTransitionInfo{};
-    layoutTransitionInfo.oldLayout      = m_ImageLayouts[imageIndex];
-    layoutTransitionInfo.newLayout      = newLayout;
-    layoutTransitionInfo.image          = m_Images[imageIndex];
-    layoutTransitionInfo.mipLevels      = 1;
-    layoutTransitionInfo.aspectFlags    = aspectFlags;
-
-    Utilities::ChangeLayout(commandBuffer, layoutTransitionInfo);
-    m_ImageLayouts[imageIndex] = newLayout;
-}
-
 Swapchain::~Swapchain()
 {
+    // Wrappers go first, they only borrow the images and views below
+    m_ImageTargets.clear();
+
     for(auto imageView : m_ImageViews)
     {
         vkDestroyImageView(m_Context->GetLogicalDevice(), imageView, nullptr);
@@ -1,6 +1,7 @@
 #pragma once
 
 class Context;
+class Image;
 
 class Swapchain
 {
@@ -17,14 +18,12 @@ public:
 
     Swapchain(const Swapchain& otherSwapchain) = delete;
     Swapchain& operator=(const Swapchain& otherSwapchain) = delete;
-public:
-    void ChangeLayout(size_t imageIndex, VkImageLayout newLayout, VkImageAspectFlags aspectFlags, VkCommandBuffer);
 public:
     inline VkFormat GetFormat() const { return m_ImageFormat; }
     inline VkSwapchainKHR GetSwapchain() const { return m_Swapchain; }
     inline VkExtent2D GetExtent() const { return m_Extent; }
     inline const std::vector<VkImageView> GetImageViews() const { return m_ImageViews; }
-    inline const std::vector<VkImageLayout> GetImageLayouts() const { return m_ImageLayouts; }
+    inline Image* GetImage(size_t imageIndex) const { return m_ImageTargets[imageIndex].get(); }
     inline static constexpr uint32_t FRAMES_IN_FLIGHT = 2;
 private:
     void Init();
@@ -36,5 +35,5 @@ private:
     VkExtent2D                  m_Extent;
     std::vector<VkImage>        m_Images;
     std::vector<VkImageView>    m_ImageViews;
-    std::vector<VkImageLayout>  m_ImageLayouts;
+    std::vector<std::unique_ptr<Image>>     m_ImageTargets;
 };
\ No newline at end of file
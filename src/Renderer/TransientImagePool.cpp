@@ -0,0 +1,154 @@
+#include "Core/CnPch.hpp"
+#include "TransientImagePool.hpp"
+
+#include "Context.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+TransientImagePool::TransientImagePool(Context* context)
+    :   m_Context{context}, m_AllocatedSize{0}, m_LazySize{0}, m_RequestedSize{0}
+{
+}
+
+void TransientImagePool::Allocate(const std::vector<ImageRequest>& requests)
+{
+    Release();
+
+    const bool lazySupported = SupportsLazyAllocation();
+
+    std::vector<Image::ImageInfo> imageInfos;
+    std::vector<VkMemoryRequirements> requirements;
+    for(const ImageRequest& request : requests)
+    {
+        Image::ImageInfo imageInfo = request.imageInfo;
+        imageInfo.desiredLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        // On tilers attachments that never leave the render pass do not need backing memory at all
+        if(lazySupported && IsAttachmentOnly(imageInfo.usageFlags))
+        {
+            imageInfo.usageFlags |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        }
+
+        imageInfos.push_back(imageInfo);
+        requirements.push_back(Image::GetMemoryRequirements(m_Context, imageInfo));
+        m_RequestedSize += requirements.back().size;
+    }
+
+    // Largest first, so smaller images end up sharing the big blocks
+    std::vector<size_t> order(requests.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&requirements](size_t a, size_t b) { return requirements[a].size > requirements[b].size; });
+
+    for(size_t request : order)
+    {
+        const VkMemoryRequirements& memoryRequirements = requirements[request];
+        const bool lazy = (imageInfos[request].usageFlags & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) != 0;
+
+        MemoryBlock* target = nullptr;
+        for(MemoryBlock& block : m_Blocks)
+        {
+            if(lazy || block.lazilyAllocated || (block.requirements.memoryTypeBits & memoryRequirements.memoryTypeBits) == 0)
+            {
+                continue;
+            }
+
+            bool disjoint = std::none_of(block.members.begin(), block.members.end(),
+                                         [&](size_t member) { return Overlaps(requests[member], requests[request]); });
+            if(disjoint)
+            {
+                target = &block;
+                break;
+            }
+        }
+
+        if(target == nullptr)
+        {
+            MemoryBlock block{};
+            block.requirements      = memoryRequirements;
+            block.lazilyAllocated   = lazy;
+            m_Blocks.push_back(block);
+            target = &m_Blocks.back();
+        } else
+        {
+            target->requirements.size           = std::max(target->requirements.size, memoryRequirements.size);
+            target->requirements.alignment      = std::max(target->requirements.alignment, memoryRequirements.alignment);
+            target->requirements.memoryTypeBits &= memoryRequirements.memoryTypeBits;
+        }
+        target->members.push_back(request);
+    }
+
+    m_Images.resize(requests.size());
+    m_AliasPredecessors.resize(requests.size());
+
+    for(MemoryBlock& block : m_Blocks)
+    {
+        VmaAllocationCreateInfo allocationCreateInfo{};
+        allocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        if(block.lazilyAllocated)
+        {
+            allocationCreateInfo.requiredFlags |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+            m_LazySize += block.requirements.size;
+        }
+
+        VK_CHECK(vmaAllocateMemory(m_Context->GetAllocator(), &block.requirements, &allocationCreateInfo, &block.allocation, nullptr))
+        m_AllocatedSize += block.requirements.size;
+
+        // Within a block the images take turns in pass order, the first one follows the last of the frame before
+        std::sort(block.members.begin(), block.members.end(), [&requests](size_t a, size_t b) { return requests[a].firstPass < requests[b].firstPass; });
+        for(size_t i = 0; i < block.members.size(); i++)
+        {
+            size_t member = block.members[i];
+            m_Images[member]            = std::make_unique<Image>(m_Context, imageInfos[member], block.allocation);
+            m_AliasPredecessors[member] = block.members[(i + block.members.size() - 1) % block.members.size()];
+        }
+    }
+}
+
+bool TransientImagePool::SupportsLazyAllocation() const
+{
+    const VkPhysicalDeviceMemoryProperties* memoryProperties = nullptr;
+    vmaGetMemoryProperties(m_Context->GetAllocator(), &memoryProperties);
+
+    for(uint32_t i = 0; i < memoryProperties->memoryTypeCount; i++)
+    {
+        if(memoryProperties->memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool TransientImagePool::IsAttachmentOnly(VkImageUsageFlags usageFlags)
+{
+    const VkImageUsageFlags attachmentFlags = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+    return (usageFlags & ~attachmentFlags) == 0;
+}
+
+bool TransientImagePool::Overlaps(const ImageRequest& request, const ImageRequest& otherRequest)
+{
+    return request.firstPass <= otherRequest.lastPass && otherRequest.firstPass <= request.lastPass;
+}
+
+void TransientImagePool::Release()
+{
+    // Images have to go before the memory they are bound to
+    m_Images.clear();
+    m_AliasPredecessors.clear();
+
+    for(MemoryBlock& block : m_Blocks)
+    {
+        vmaFreeMemory(m_Context->GetAllocator(), block.allocation);
+    }
+    m_Blocks.clear();
+    m_AllocatedSize = 0;
+    m_LazySize      = 0;
+    m_RequestedSize = 0;
+}
+
+TransientImagePool::~TransientImagePool()
+{
+    Release();
+}
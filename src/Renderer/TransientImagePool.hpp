@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Image.hpp"
+
+class Context;
+
+class TransientImagePool
+{
+public:
+    struct ImageRequest
+    {
+        Image::ImageInfo    imageInfo;
+        // Inclusive range of the passes using the image
+        uint32_t            firstPass;
+        uint32_t            lastPass;
+    };
+public:
+    explicit TransientImagePool(Context* context);
+    ~TransientImagePool();
+
+    TransientImagePool(const TransientImagePool& otherPool) = delete;
+    TransientImagePool& operator=(const TransientImagePool& otherPool) = delete;
+public:
+    void Allocate(const std::vector<ImageRequest>& requests);
+public:
+    inline Image* GetImage(size_t request) const { return m_Images[request].get(); }
+    // The request that used the memory before this one, the request itself when nothing else shares it
+    inline size_t GetAliasPredecessor(size_t request) const { return m_AliasPredecessors[request]; }
+    inline VkDeviceSize GetAllocatedSize() const { return m_AllocatedSize; }
+    inline VkDeviceSize GetLazySize() const { return m_LazySize; }
+    // What the requests would take with a dedicated allocation each
+    inline VkDeviceSize GetRequestedSize() const { return m_RequestedSize; }
+    inline size_t GetBlockCount() const { return m_Blocks.size(); }
+private:
+    struct MemoryBlock
+    {
+        VmaAllocation           allocation{};
+        VkMemoryRequirements    requirements{};
+        bool                    lazilyAllocated{false};
+        std::vector<size_t>     members;
+    };
+private:
+    bool SupportsLazyAllocation() const;
+    static bool IsAttachmentOnly(VkImageUsageFlags usageFlags);
+    static bool Overlaps(const ImageRequest& request, const ImageRequest& otherRequest);
+    void Release();
+private:
+    Context*                                m_Context;
+    std::vector<MemoryBlock>                m_Blocks;
+    std::vector<std::unique_ptr<Image>>     m_Images;
+    std::vector<size_t>                     m_AliasPredecessors;
+    VkDeviceSize                            m_AllocatedSize;
+    VkDeviceSize                            m_LazySize;
+    VkDeviceSize                            m_RequestedSize;
+};
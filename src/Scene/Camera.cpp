@@ -10,7 +10,7 @@
 #include "glfw/glfw3.h"
 
 Camera::Camera(Context* context)
-    :   m_Context{context}, m_CameraExtent{}, m_BufferObjects{}, m_Position{0.0f},
+    :   m_Context{context}, m_CameraExtent{}, m_BufferObject{}, m_Position{0.0f},
         m_Target{0.0f, 0.0f, -1.0f}, m_Up{0.0f, 1.0f, 0.0f}, m_Speed{0.025f}, m_AngleHorizontal{-90.0f}, m_AngleVertical{0.0f},
         m_MousePosX{(double)m_CameraExtent.width/2}, m_MousePosY{(double)m_CameraExtent.height/2}, m_Exposure{1.0f}
 {
@@ -46,7 +46,8 @@ void Camera::CreateDescriptorSet()
         DescriptorSet::BindingInfo bindingInfo{};
         bindingInfo.type        = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
         bindingInfo.binding     = 0;
-        bindingInfo.stageFlags  = VK_SHADER_STAGE_VERTEX_BIT;
+        // The culling pass takes its frustum planes from the view projection matrix
+        bindingInfo.stageFlags  = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
         bindingInfo.bufferInfo  = &bufferInfo;
         bindings.push_back(bindingInfo);
 
@@ -54,24 +55,24 @@ void Camera::CreateDescriptorSet()
     }
 }
 
-void Camera::WriteBuffer(const uint32_t frameIndex)
+void Camera::WriteBuffer(const uint32_t frameIndex, const CameraBufferObject& bufferObject)
 {
-    m_Buffers[frameIndex]->Map(&m_BufferObjects[frameIndex], m_Buffers[frameIndex]->GetSize());
+    m_Buffers[frameIndex]->Map(&bufferObject, sizeof(CameraBufferObject));
 }
 
 void Camera::SetExtent(const VkExtent2D extent)
 {
     m_CameraExtent = extent;
 
-    for(size_t i = 0; i < m_BufferObjects.size(); i++)
-    {
-        m_BufferObjects[i].projectionMatrix = glm::perspective(glm::radians(45.0f), (float)m_CameraExtent.width/(float)m_CameraExtent.height, 0.1f, 1000.0f);
-        m_BufferObjects[i].projectionMatrix[1][1] *= -1;
-        m_BufferObjects[i].viewMatrix = glm::mat4(1.0f);
+    m_BufferObject.projectionMatrix = glm::perspective(glm::radians(45.0f), (float)m_CameraExtent.width/(float)m_CameraExtent.height, NEAR_PLANE, FAR_PLANE);
+    m_BufferObject.projectionMatrix[1][1] *= -1;
+    m_BufferObject.viewMatrix = glm::mat4(1.0f);
 
-        m_BufferObjects[i].viewProjectionMatrix = m_BufferObjects[i].projectionMatrix * m_BufferObjects[i].viewMatrix;
+    m_BufferObject.viewProjectionMatrix = m_BufferObject.projectionMatrix * m_BufferObject.viewMatrix;
 
-        WriteBuffer(i);
+    for(size_t i = 0; i < m_Buffers.size(); i++)
+    {
+        WriteBuffer(i, m_BufferObject);
     }
 }
 
@@ -143,7 +144,7 @@ void Camera::ProcessMouseMovements(GLFWwindow* window)
     UpdateCameraUVN();
 }
 
-glm::mat4 Camera::CreateCameraMatrix()
+glm::mat4 Camera::CreateCameraMatrix() const
 {
     glm::vec3 nAxis = m_Target;
     glm::normalize(nAxis);
@@ -197,14 +198,27 @@ void Camera::UpdateCameraUVN()
     glm::normalize(m_Up);
 }
 
+void Camera::SetPose(const glm::vec3& position, const glm::vec3& direction)
+{
+    glm::vec3 view = glm::normalize(direction);
+
+    // Inverse of the rotations in UpdateCameraUVN so mouse look continues from the same orientation
+    m_Position          = position;
+    m_AngleHorizontal   = glm::degrees(std::atan2(-view.z, view.x));
+    m_AngleVertical     = glm::degrees(-std::asin(glm::clamp(view.y, -1.0f, 1.0f)));
+
+    UpdateCameraUVN();
+}
+
 void Camera::PrintPosition()
 {
     std::cout << "(" << m_Position.x << ", " << m_Position.y << ", " << m_Position.z << ")\n";
 }
 
-void Camera::Update(const uint32_t frameIndex)
+void Camera::Update()
 {
-    m_BufferObjects[frameIndex].viewMatrix = CreateCameraMatrix();
-    m_BufferObjects[frameIndex].viewProjectionMatrix = m_BufferObjects[frameIndex].projectionMatrix * m_BufferObjects[frameIndex].viewMatrix;
-    WriteBuffer(frameIndex);
+    CN_PROFILE_FUNCTION();
+
+    m_BufferObject.viewMatrix = CreateCameraMatrix();
+    m_BufferObject.viewProjectionMatrix = m_BufferObject.projectionMatrix * m_BufferObject.viewMatrix;
 }
\ No newline at end of file
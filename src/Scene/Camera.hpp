@@ -22,18 +22,26 @@ public:
     explicit Camera(Context* context);
     ~Camera() = default;
 public:
-    void WriteBuffer(uint32_t frameIndex);
+    // Render thread, once the frame slot's fence signalled. The matrices come from the frame's render packet
+    void WriteBuffer(uint32_t frameIndex, const CameraBufferObject& bufferObject);
     void SetExtent(VkExtent2D extent);
     void ProcessKeyboardInputs(GLFWwindow* window);
     void ProcessMouseMovements(GLFWwindow* window);
-    void Update(uint32_t frameIndex);
-    glm::mat4 CreateCameraMatrix();
+    void Update();
+    // Places the camera without input, used by scripted camera paths
+    void SetPose(const glm::vec3& position, const glm::vec3& direction);
+    glm::mat4 CreateCameraMatrix() const;
 public:
     inline VkDescriptorSetLayout GetCameraLayout() const { return m_DescriptorSets[0]->GetDescriptorSetLayout(); }
     inline VkDescriptorSet GetDescriptorSet(const uint32_t frameIndex) const { return m_DescriptorSets[frameIndex]->GetDescriptorSet(); }
     inline const glm::vec3& GetPosition() const { return m_Position; }
+    // As computed by the last Update
+    inline const CameraBufferObject& GetBufferObject() const { return m_BufferObject; }
     inline float GetExposure() const { return m_Exposure; }
     inline void SetExposure(float exposure) { m_Exposure = exposure; }
+    // Depth range of the projection, the light clusters are sliced along it
+    inline static constexpr float NEAR_PLANE  = 0.1f;
+    inline static constexpr float FAR_PLANE   = 1000.0f;
 private:
     void CreateDescriptorBuffers();
     void CreateDescriptorSet();
@@ -45,7 +53,7 @@ private:
     VkExtent2D                                                              m_CameraExtent;
     std::array<std::unique_ptr<DescriptorSet>, Swapchain::FRAMES_IN_FLIGHT> m_DescriptorSets;
     std::array<std::unique_ptr<Buffer>, Swapchain::FRAMES_IN_FLIGHT>        m_Buffers;
-    std::array<CameraBufferObject, Swapchain::FRAMES_IN_FLIGHT>             m_BufferObjects;
+    CameraBufferObject                                                      m_BufferObject;
 private:
     glm::vec3   m_Position;
     glm::vec3   m_Target;
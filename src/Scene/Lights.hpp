@@ -4,6 +4,8 @@
 
 namespace Lights
 {
+    // Matches PointLight in LightCulling.comp and Lighting.frag (std430), the renderer uploads these as they are.
+    // radius bounds the light's reach, which decides the clusters it is binned into
     struct PointLight
     {
         glm::vec3 position = glm::vec3(0.0f, 0.0f, 0.0f);
@@ -20,12 +22,4 @@ namespace Lights
     {
 
     };
-
-    struct LightBufferObject
-    {
-        PointLight  pointlights[MAX_POINT_LIGHTS_SIZE];
-        uint32_t    numPointLights{};
-        alignas(16) glm::vec3 viewPos{0.0f};
-        alignas(16) glm::mat4 viewMatrix{1.0f};
-    };
 }
@@ -25,6 +25,7 @@ public:
     Lights::PointLight* AddPointLight(Lights::PointLight pointLight);
 public:
     inline Camera& GetCamera() { return m_Camera; }
+    inline const Camera& GetCamera() const { return m_Camera; }
     inline const std::vector<SceneMember>& GetSceneMembers() const { return m_SceneMembers; }
     inline const std::vector<Lights::PointLight>& GetPointLights() const { return m_PointLights; }
     inline std::vector<Lights::PointLight>& GetPointLights() { return m_PointLights; }
@@ -7,8 +7,9 @@
 
 SceneMember::SceneMember(Mesh* mesh)
     :   m_Mesh{mesh}, m_Translation{0.0f},
-        m_Rotation{0.0f}, m_Scale{1.0f}, m_ModelMatrix{1.0f}
+        m_Rotation{0.0f}, m_Scale{1.0f}, m_ModelMatrix{1.0f}, m_WorldBounds{}
 {
+    UpdateWorldBounds();
 }
 
 SceneMember& SceneMember::Translate(float x, float y, float z)
@@ -49,4 +50,17 @@ void SceneMember::UpdateModelMatrix()
     m_ModelMatrix = glm::rotate(m_ModelMatrix, m_Rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
 
     m_ModelMatrix = glm::scale(m_ModelMatrix, m_Scale);
+
+    UpdateWorldBounds();
+}
+
+void SceneMember::UpdateWorldBounds()
+{
+    m_WorldBounds = Bounds::Transform(m_Mesh->GetBounds(), m_ModelMatrix);
+
+    m_SubMeshWorldBounds.resize(m_Mesh->m_SubMeshes.size());
+    for(size_t i = 0; i < m_SubMeshWorldBounds.size(); i++)
+    {
+        m_SubMeshWorldBounds[i] = Bounds::Transform(m_Mesh->m_SubMeshes[i].GetBounds(), m_ModelMatrix);
+    }
 }
\ No newline at end of file
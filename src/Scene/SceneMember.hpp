@@ -24,10 +24,18 @@ public:
 public:
     inline const Mesh* GetMesh() const { return m_Mesh; }
     inline const glm::mat4& GetModelMatrix() const { return m_ModelMatrix; }
+    // World space, refreshed by UpdateModelMatrix
+    inline const Bounds::BoundingVolume& GetWorldBounds() const { return m_WorldBounds; }
+    // Indexed like the mesh's submeshes
+    inline const std::vector<Bounds::BoundingVolume>& GetSubMeshWorldBounds() const { return m_SubMeshWorldBounds; }
 private:
-    Mesh*                   m_Mesh;
-    glm::vec3               m_Translation;
-    glm::vec3               m_Rotation;
-    glm::vec3               m_Scale;
-    glm::mat4               m_ModelMatrix;
+    void UpdateWorldBounds();
+private:
+    Mesh*                               m_Mesh;
+    glm::vec3                           m_Translation;
+    glm::vec3                           m_Rotation;
+    glm::vec3                           m_Scale;
+    glm::mat4                           m_ModelMatrix;
+    Bounds::BoundingVolume              m_WorldBounds;
+    std::vector<Bounds::BoundingVolume> m_SubMeshWorldBounds;
 };